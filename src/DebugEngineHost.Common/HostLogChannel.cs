@@ -6,8 +6,11 @@
  */
 
 using System;
+using System.Collections.Concurrent;
 using System.Globalization;
 using System.IO;
+using System.Text;
+using System.Threading;
 
 namespace Microsoft.DebugEngineHost
 {
@@ -48,26 +51,66 @@ namespace Microsoft.DebugEngineHost
         void Close();
     }
 
+    /// <summary>
+    /// Log channel which queues lines and writes them on a background thread, so that logging does not slow down the
+    /// thread reading debugger output. The queue is drained when it reaches a high-water mark, when an error is logged,
+    /// and at least every <see cref="FlushIntervalMs"/>. The file is flushed after each batch rather than after each line.
+    /// </summary>
     public class HostLogChannel : ILogChannel
     {
+        private const int HighWaterMark = 256;              // wake the writer once this many lines are queued
+        private const int MaxPendingLines = 64 * 1024;      // callers write synchronously beyond this so memory stays bounded
+        private const int FlushIntervalMs = 100;
+        private const int FileBufferSize = 64 * 1024;
+
         private readonly Action<string>? _log;
+        private readonly string? _fileName;
+        private readonly long _maxFileSize;
         private StreamWriter? _logFile;
+        private long _fileSize;
         private LogLevel _minLevelToBeLogged;
 
-        private readonly object _lock = new object();
+        private readonly ConcurrentQueue<string> _pending = new ConcurrentQueue<string>();
+        private int _pendingCount;
+        private readonly AutoResetEvent _wakeWriter = new AutoResetEvent(false);
+        private readonly Thread _writerThread;
+        private volatile bool _closed;
 
-        private HostLogChannel() { }
+        // Held while lines move from the queue to the outputs, so they are written in order
+        private readonly object _writeLock = new object();
 
-        public HostLogChannel(Action<string>? logAction, string? file, LogLevel logLevel)
+        /// <summary>
+        /// Creates a log channel.
+        /// </summary>
+        /// <param name="logAction">Callback which receives each line, or null</param>
+        /// <param name="file">File to write the log to, or null</param>
+        /// <param name="logLevel">Minimum level to log</param>
+        /// <param name="maxFileSize">If non-zero, once the file reaches roughly this many bytes it is renamed to [file].1 and a new file is started</param>
+        public HostLogChannel(Action<string>? logAction, string? file, LogLevel logLevel, long maxFileSize = 0)
         {
             _log = logAction;
 
             if (!IsNullOrEmpty(file))
             {
-                _logFile = File.CreateText(file);
+                _fileName = file;
+                _maxFileSize = maxFileSize;
+                _logFile = CreateLogFile(file);
             }
 
             _minLevelToBeLogged = logLevel;
+
+            _writerThread = new Thread(WriterLoop);
+            _writerThread.Name = "MIEngine log writer";
+            _writerThread.IsBackground = true;
+            _writerThread.Start();
+
+            AppDomain.CurrentDomain.ProcessExit += OnProcessExit;
+        }
+
+        private static StreamWriter CreateLogFile(string file)
+        {
+            var stream = new FileStream(file, FileMode.Create, FileAccess.Write, FileShare.Read);
+            return new StreamWriter(stream, new UTF8Encoding(encoderShouldEmitUTF8Identifier: false), FileBufferSize);
         }
 
         /// <summary>
@@ -80,64 +123,168 @@ namespace Microsoft.DebugEngineHost
         }
 
         /// <summary>
-        /// 
+        /// Queues a line to be written to the log.
         /// </summary>
-        /// <param name="verbosity"></param>
-        /// <param name="message"></param>
+        /// <param name="level">The level of the message</param>
+        /// <param name="message">The message</param>
         public void WriteLine(LogLevel level, string message)
         {
             if (level >= _minLevelToBeLogged)
             {
-                lock (_lock)
+                // Only indicate level if not verbose.
+                string levelMsg = level == LogLevel.Verbose ? message : "[" + level.ToString() + "] " + message;
+
+                if (_closed)
                 {
-                    string prefix = string.Empty;
-                    // Only indicate level if not verbose.
-                    if (level != LogLevel.Verbose)
+                    lock (_writeLock)
                     {
-                        prefix = string.Format(CultureInfo.InvariantCulture, "[{0}] ", level.ToString());
+                        _log?.Invoke(levelMsg);
                     }
-                    string levelMsg = string.Format(CultureInfo.InvariantCulture, "{0}{1}", prefix, message);
-                    _log?.Invoke(levelMsg);
-                    _logFile?.WriteLine(levelMsg);
-                    _logFile?.Flush();
+                    return;
                 }
 
+                _pending.Enqueue(levelMsg);
+                int count = Interlocked.Increment(ref _pendingCount);
+                if (count > MaxPendingLines)
+                {
+                    // The writer is falling behind, so help it out
+                    lock (_writeLock)
+                    {
+                        WritePending();
+                    }
+                }
+                else if (count == HighWaterMark || level >= LogLevel.Error)
+                {
+                    _wakeWriter.Set();
+                }
             }
         }
 
         /// <summary>
-        /// 
+        /// Formats a message and queues it to be written to the log.
         /// </summary>
-        /// <param name="verbosity"></param>
-        /// <param name="format"></param>
-        /// <param name="values"></param>
+        /// <param name="level">The level of the message</param>
+        /// <param name="format">Format string</param>
+        /// <param name="values">Values to use in the format string</param>
         public void WriteLine(LogLevel level, string format, params object[] values)
         {
             if (level >= _minLevelToBeLogged)
             {
-                lock (_lock)
-                {
-                    string message = string.Format(CultureInfo.CurrentCulture, format, values);
-                    this.WriteLine(level, message);
-                }
+                this.WriteLine(level, string.Format(CultureInfo.CurrentCulture, format, values));
             }
         }
 
+        /// <summary>
+        /// Writes out everything queued so far and flushes the file.
+        /// </summary>
         public void Flush()
         {
-            lock (_lock)
+            lock (_writeLock)
             {
-                _logFile?.Flush();
+                WritePending();
             }
         }
 
         public void Close()
         {
-            lock (_lock)
+            lock (_writeLock)
+            {
+                if (_closed)
+                {
+                    return;
+                }
+                _closed = true;
+            }
+
+            AppDomain.CurrentDomain.ProcessExit -= OnProcessExit;
+            _wakeWriter.Set();
+            if (Thread.CurrentThread != _writerThread)
             {
+                _writerThread.Join();
+            }
+
+            lock (_writeLock)
+            {
+                WritePending();
                 _logFile?.Close();
                 _logFile = null;
             }
         }
+
+        private void OnProcessExit(object? sender, EventArgs e)
+        {
+            Flush();
+        }
+
+        private void WriterLoop()
+        {
+            while (!_closed)
+            {
+                _wakeWriter.WaitOne(FlushIntervalMs);
+                lock (_writeLock)
+                {
+                    WritePending();
+                }
+            }
+        }
+
+        // Must be called with _writeLock held
+        private void WritePending()
+        {
+            bool wroteFile = false;
+            while (_pending.TryDequeue(out string? line))
+            {
+                Interlocked.Decrement(ref _pendingCount);
+                try
+                {
+                    _log?.Invoke(line);
+                    if (_logFile != null)
+                    {
+                        _logFile.WriteLine(line);
+                        wroteFile = true;
+                        _fileSize += line.Length + Environment.NewLine.Length;
+                        if (_maxFileSize > 0 && _fileSize >= _maxFileSize)
+                        {
+                            RotateLogFile();
+                        }
+                    }
+                }
+                catch (Exception)
+                {
+                    // Nowhere to report a failure to log, and it must not take down the writer thread
+                }
+            }
+
+            if (wroteFile)
+            {
+                try
+                {
+                    _logFile?.Flush();
+                }
+                catch (IOException)
+                {
+                }
+            }
+        }
+
+        private void RotateLogFile()
+        {
+            _logFile!.Close();
+            _logFile = null;
+            _fileSize = 0;
+
+            string backup = _fileName + ".1";
+            try
+            {
+                File.Delete(backup);
+                File.Move(_fileName!, backup);
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                // Keep logging into the existing file name, the old contents are lost
+            }
+
+            _logFile = CreateLogFile(_fileName!);
+        }
     }
 }
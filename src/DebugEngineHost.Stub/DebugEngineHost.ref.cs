@@ -283,6 +283,16 @@ namespace Microsoft.DebugEngineHost
             throw new NotImplementedException();
         }
 
+        /// <summary>
+        /// Sets the log file to write to, starting a new file when it grows too large.
+        /// </summary>
+        /// <param name="logFile">The file to write engine logs to, or null if none</param>
+        /// <param name="maxFileSize">Size in bytes at which the file is renamed to [logFile].1 and a new one started, or 0 for no limit</param>
+        public static void SetEngineLogFile(string? logFile, long maxFileSize)
+        {
+            throw new NotImplementedException();
+        }
+
         /// <summary>
         /// Gets the engine log channel created by 'EnableHostLogging'
         /// </summary>
@@ -62,6 +62,76 @@ namespace Microsoft.VisualStudio.Debugger.Interop.DAP
         int AutoComplete([In] string command, [In] IDebugStackFrame2 stackFrame, [Out] out string[] result);
     }
 
+    /// <summary>
+    /// IDebugThreadDAP for Debug Adapter Protocol
+    /// </summary>
+    [ComImport()]
+    [ComVisible(true)]
+    [Guid("F8DC4116-AE11-4C12-9D6C-6323342CF3BE")]
+    [InterfaceType(1)]
+    public interface IDebugThreadDAP
+    {
+        /// <summary>
+        /// Retrieves a range of the thread's stack frames, so that only the frames a stackTrace request asks for need to be walked.
+        /// </summary>
+        /// <param name="dwFieldSpec">Fields to fill in for each frame.</param>
+        /// <param name="nRadix">Radix for numerical values.</param>
+        /// <param name="startFrame">Index of the first frame to return.</param>
+        /// <param name="levels">Maximum number of frames to return, or 0 for all remaining frames.</param>
+        /// <param name="ppEnum">The frames in the range.</param>
+        /// <param name="totalFrames">Number of frames on the stack. May be larger than the number of frames available when the stack hasn't been completely walked.</param>
+        [PreserveSig]
+        int EnumFrameInfoRange([In] enum_FRAMEINFO_FLAGS dwFieldSpec, [In] uint nRadix, [In] uint startFrame, [In] uint levels, [Out, MarshalAs(UnmanagedType.Interface)] out IEnumDebugFrameInfo2 ppEnum, [Out] out uint totalFrames);
+    }
+
+    /// <summary>
+    /// IDebugPropertyDAP for Debug Adapter Protocol
+    /// </summary>
+    [ComImport()]
+    [ComVisible(true)]
+    [Guid("2E7B5A0D-94C1-4B6F-8E3A-5D0C7F1B9A64")]
+    [InterfaceType(1)]
+    public interface IDebugPropertyDAP
+    {
+        /// <summary>
+        /// Retrieves the number of indexed children (array elements) of the property, which can be enumerated a range at a time with EnumChildrenRange.
+        /// </summary>
+        /// <param name="pCount">Number of indexed children.</param>
+        /// <returns>S_OK if the property has indexed children, otherwise S_FALSE.</returns>
+        [PreserveSig]
+        int GetIndexedChildCount([Out] out uint pCount);
+
+        /// <summary>
+        /// Enumerates a range of the property's indexed children, so that only the elements a variables request asks for are fetched.
+        /// </summary>
+        /// <param name="dwFields">Fields to fill in for each child.</param>
+        /// <param name="dwRadix">Radix for numerical values.</param>
+        /// <param name="start">Index of the first child to return.</param>
+        /// <param name="count">Maximum number of children to return.</param>
+        /// <param name="dwTimeout">Timeout in milliseconds.</param>
+        /// <param name="ppEnum">The children in the range.</param>
+        [PreserveSig]
+        int EnumChildrenRange([In] enum_DEBUGPROP_INFO_FLAGS dwFields, [In] uint dwRadix, [In] uint start, [In] uint count, [In] uint dwTimeout, [Out, MarshalAs(UnmanagedType.Interface)] out IEnumDebugPropertyInfo2 ppEnum);
+    }
+
+    /// <summary>
+    /// IDebugBreakpointRequestDAP for Debug Adapter Protocol
+    /// </summary>
+    [ComImport()]
+    [ComVisible(true)]
+    [Guid("8B3F6C21-5D4E-4A97-B0C8-1E9F2A7D6354")]
+    [InterfaceType(1)]
+    public interface IDebugBreakpointRequestDAP
+    {
+        /// <summary>
+        /// Retrieves the log message of a logpoint, so that an engine can print it without stopping the process.
+        /// </summary>
+        /// <param name="parts">The parsed message. Even elements are literal text, odd elements are interpolations: either a '{expression}' or a token such as '$FUNCTION'.</param>
+        /// <returns>S_OK if the breakpoint is a logpoint, otherwise S_FALSE.</returns>
+        [PreserveSig]
+        int GetLogMessage([Out] out string[] parts);
+    }
+
     /// <summary>
     /// IDebugMemoryBytesDAP for Debug Adapter Protocol
     /// </summary>
@@ -11,6 +11,7 @@ namespace Microsoft.DebugEngineHost
         private static ILogChannel? s_engineLogChannel;
 
         private static string? s_engineLogFile;
+        private static long s_engineLogFileMaxSize;
 
         public static void EnableNatvisDiagnostics(Action<string> callback, LogLevel level = LogLevel.Verbose)
         {
@@ -25,13 +26,19 @@ namespace Microsoft.DebugEngineHost
         {
             if (s_engineLogChannel is null)
             {
-                s_engineLogChannel = new HostLogChannel(callback, s_engineLogFile, level);
+                s_engineLogChannel = new HostLogChannel(callback, s_engineLogFile, level, s_engineLogFileMaxSize);
             }
         }
 
         public static void SetEngineLogFile(string? logFile)
+        {
+            SetEngineLogFile(logFile, 0);
+        }
+
+        public static void SetEngineLogFile(string? logFile, long maxFileSize)
         {
             s_engineLogFile = logFile;
+            s_engineLogFileMaxSize = maxFileSize;
         }
 
         public static ILogChannel? GetEngineLogChannel()
@@ -15,6 +15,7 @@ namespace Microsoft.DebugEngineHost
         private static ILogChannel? s_engineLogChannel;
 
         private static string? s_engineLogFile;
+        private static long s_engineLogFileMaxSize;
 
         private static FeedbackLogBuffer? s_circularBuffer;
         private static VSFeedbackLogger? s_feedbackLogger;
@@ -23,7 +24,7 @@ namespace Microsoft.DebugEngineHost
         {
             if (s_engineLogChannel is null)
             {
-                s_engineLogChannel = new HostLogChannel(callback, s_engineLogFile, level);
+                s_engineLogChannel = new HostLogChannel(callback, s_engineLogFile, level, s_engineLogFileMaxSize);
             }
 
             if (s_feedbackLogger is null)
@@ -46,8 +47,14 @@ namespace Microsoft.DebugEngineHost
         }
 
         public static void SetEngineLogFile(string? logFile)
+        {
+            SetEngineLogFile(logFile, 0);
+        }
+
+        public static void SetEngineLogFile(string? logFile, long maxFileSize)
         {
             s_engineLogFile = logFile;
+            s_engineLogFileMaxSize = maxFileSize;
         }
 
         public static ILogChannel? GetEngineLogChannel()
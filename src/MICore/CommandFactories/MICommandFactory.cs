@@ -377,13 +377,39 @@ namespace MICore
 
         public virtual async Task<Results> VarListChildren(string variableReference, enum_DEBUGPROP_INFO_FLAGS dwFlags, ResultClass resultClass = ResultClass.done)
         {
-            // Limit the number of children expanded to 1000 in case memory is uninitialized
-            string command = string.Format(CultureInfo.InvariantCulture, "-var-list-children --simple-values \"{0}\" 0 1000", variableReference);
+            string command = GetVarListChildrenCommand(variableReference, 0, MaxListedChildren);
             Results results = await _debugger.CmdAsync(command, resultClass);
 
             return results;
         }
 
+        /// <summary>
+        /// Lists the children [from, to) of a variable object
+        /// </summary>
+        public virtual async Task<Results> VarListChildren(string variableReference, enum_DEBUGPROP_INFO_FLAGS dwFlags, uint from, uint to, ResultClass resultClass = ResultClass.done)
+        {
+            string command = GetVarListChildrenCommand(variableReference, from, to);
+            Results results = await _debugger.CmdAsync(command, resultClass);
+
+            return results;
+        }
+
+        /// <summary>
+        /// Lists the children of several variable objects, sending all of the commands back-to-back
+        /// </summary>
+        public virtual Task<Results[]> VarListChildrenBatch(IReadOnlyList<string> variableReferences, enum_DEBUGPROP_INFO_FLAGS dwFlags, ResultClass resultClass = ResultClass.done)
+        {
+            return _debugger.CmdBatchAsync(variableReferences.Select(v => GetVarListChildrenCommand(v, 0, MaxListedChildren)).ToList(), resultClass);
+        }
+
+        // Limit the number of children expanded at once to 1000 in case memory is uninitialized
+        public const uint MaxListedChildren = 1000;
+
+        protected virtual string GetVarListChildrenCommand(string variableReference, uint from, uint to)
+        {
+            return string.Format(CultureInfo.InvariantCulture, "-var-list-children --simple-values \"{0}\" {1} {2}", variableReference, from, to);
+        }
+
         public async Task<Results> VarEvaluateExpression(string variableName, ResultClass resultClass = ResultClass.done)
         {
             string command = string.Format(CultureInfo.InvariantCulture, @"-var-evaluate-expression {0}", variableName);
@@ -426,6 +452,24 @@ namespace MICore
             await _debugger.CmdAsync(command, ResultClass.None);
         }
 
+        /// <summary>
+        /// Deletes several variable objects, sending all of the commands back-to-back
+        /// </summary>
+        public async Task VarDeleteBatch(IReadOnlyList<string> variableNames)
+        {
+            await _debugger.CmdBatchAsync(variableNames.Select(n => string.Format(CultureInfo.InvariantCulture, "-var-delete {0}", n)).ToList(), ResultClass.None);
+        }
+
+        /// <summary>
+        /// Re-evaluates a variable object and its children
+        /// </summary>
+        /// <returns>Results with a "changelist" of the objects whose value, type or number of children changed</returns>
+        public async Task<Results> VarUpdate(string variableName, ResultClass resultClass = ResultClass.done)
+        {
+            string command = string.Format(CultureInfo.InvariantCulture, "-var-update --all-values {0}", variableName);
+            return await _debugger.CmdAsync(command, resultClass);
+        }
+
         public async Task<string> VarInfoPathExpression(string variableName)
         {
             string command = string.Format(CultureInfo.InvariantCulture, "-var-info-path-expression {0}", variableName);
@@ -492,6 +536,13 @@ namespace MICore
                 cmd.Append(' ');
             }
 
+            AppendSourceLocation(cmd, filename, useUnixFormat, line);
+
+            return await _debugger.CmdAsync(cmd.ToString(), resultClass);
+        }
+
+        private void AppendSourceLocation(StringBuilder cmd, string filename, bool useUnixFormat, uint line)
+        {
             string filenameMI;
             bool quotes = PreparePath(filename, useUnixFormat, out filenameMI);
             if (quotes)
@@ -505,10 +556,64 @@ namespace MICore
             {
                 cmd.Append('\"');
             }
+        }
+
+        /// <summary>
+        /// True if the debugger can insert dynamic printf breakpoints, which print a message without stopping the process
+        /// </summary>
+        public virtual bool SupportsDprintf { get { return false; } }
+
+        /// <summary>
+        /// Inserts a dynamic printf of a constant message at a source line. <paramref name="format"/> is a printf format
+        /// without conversions: arguments would be formatted by calling printf functions in the debuggee.
+        /// </summary>
+        public virtual async Task<Results> DprintfInsert(string filename, bool useUnixFormat, uint line, string condition, bool enabled, string format, ResultClass resultClass = ResultClass.done)
+        {
+            StringBuilder cmd = new StringBuilder("-dprintf-insert -f ");
+            if (condition != null)
+            {
+                cmd.Append("-c \"");
+                cmd.Append(EscapeQuotes(condition));
+                cmd.Append("\" ");
+            }
+            if (!enabled)
+            {
+                cmd.Append("-d ");
+            }
+
+            AppendSourceLocation(cmd, filename, useUnixFormat, line);
+
+            cmd.Append(' ');
+            cmd.Append(ToCString(format));
 
             return await _debugger.CmdAsync(cmd.ToString(), resultClass);
         }
 
+        /// <summary>
+        /// Defines the breakpoint type <see cref="LogpointInsert"/> inserts. Returns false if the debugger can't define it.
+        /// </summary>
+        public virtual Task<bool> DefineLogpointType()
+        {
+            return Task.FromResult(false);
+        }
+
+        /// <summary>
+        /// Inserts a breakpoint at a source line which prints a logpoint message when it is hit, without stopping. The
+        /// message is alternating literal text and interpolations ("{expression}" or "$FUNCTION", "$TID", "$PID"), which
+        /// the debugger evaluates itself. The condition is evaluated by the breakpoint too, so it has to be changed with
+        /// <see cref="LogpointCondition"/> rather than <see cref="BreakCondition"/>.
+        /// </summary>
+        /// <returns>A result with the "bkpt" tuple of the breakpoint, or an error</returns>
+        public virtual Task<Results> LogpointInsert(string filename, bool useUnixFormat, uint line, string? condition, bool enabled, IReadOnlyList<string> messageParts)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual Task LogpointCondition(string bkptno, string? expr)
+        {
+            throw new NotImplementedException();
+        }
+
         public virtual async Task<Results> BreakInsert(string functionName, string condition, bool enabled, ResultClass resultClass = ResultClass.done)
         {
             StringBuilder cmd = await BuildBreakInsert(condition, enabled);
@@ -535,6 +640,23 @@ namespace MICore
         public virtual async Task<TupleValue?> BreakInfo(string bkptno)
         {
             Results bindResult = await _debugger.CmdAsync("-break-info " + bkptno, ResultClass.None);
+            return GetBreakInfo(bindResult);
+        }
+
+        /// <summary>
+        /// Gets the information for several breakpoints. The -break-info commands are sent back-to-back instead of
+        /// waiting for each reply.
+        /// </summary>
+        /// <param name="bkptnos">Breakpoint numbers</param>
+        /// <returns>The breakpoint tuple for each breakpoint number, or null for breakpoints the debugger fails on</returns>
+        public virtual async Task<TupleValue?[]> BreakInfoBatch(IReadOnlyList<string> bkptnos)
+        {
+            Results[] bindResults = await _debugger.CmdBatchAsync(bkptnos.Select(n => "-break-info " + n).ToList(), ResultClass.None);
+            return bindResults.Select(GetBreakInfo).ToArray();
+        }
+
+        private static TupleValue? GetBreakInfo(Results bindResult)
+        {
             if (bindResult.ResultClass != ResultClass.done)
             {
                 return null;
@@ -636,6 +758,33 @@ namespace MICore
             throw new NotImplementedException();
         }
 
+        /// <summary>
+        /// Lists the shared libraries loaded in the target.
+        /// </summary>
+        /// <returns>The 'shared-libraries' list, or null if the debugger doesn't support -file-list-shared-libraries</returns>
+        public virtual async Task<ValueListValue?> FileListSharedLibraries()
+        {
+            Results results = await _debugger.CmdAsync("-file-list-shared-libraries", ResultClass.None);
+            return results.ResultClass == ResultClass.done ? results.TryFind<ValueListValue>("shared-libraries") : null;
+        }
+
+        /// <summary>
+        /// Lists a set of shared libraries, one -file-list-shared-libraries command per library sent back-to-back.
+        /// </summary>
+        /// <param name="hostNames">Host file names of the libraries</param>
+        /// <returns>The 'shared-libraries' list for each library, or null if the debugger doesn't support -file-list-shared-libraries</returns>
+        public virtual async Task<ValueListValue[]?> FileListSharedLibraries(IReadOnlyList<string> hostNames)
+        {
+            // The argument is a regular expression in gdb's re_comp (Emacs) syntax matched against the host file name
+            var commands = hostNames.Select(name => "-file-list-shared-libraries \"^" + EscapeGdbRegex(name).Replace("\\", "\\\\").Replace("\"", "\\\"") + "$\"").ToList();
+            Results[] results = await _debugger.CmdBatchAsync(commands, ResultClass.None);
+            if (results.Any(r => r.ResultClass != ResultClass.done))
+            {
+                return null;
+            }
+            return results.Select(r => r.TryFind<ValueListValue>("shared-libraries") ?? new ValueListValue(new List<ResultValue>())).ToArray();
+        }
+
         #endregion
 
         #region Helpers
@@ -656,6 +805,29 @@ namespace MICore
             return str.Replace("\"", "\\\"");
         }
 
+        /// <summary>
+        /// Quotes a string as an MI c-string
+        /// </summary>
+        internal static string ToCString(string str)
+        {
+            StringBuilder builder = new StringBuilder(str.Length + 2);
+            builder.Append('"');
+            foreach (char c in str)
+            {
+                switch (c)
+                {
+                    case '"': builder.Append("\\\""); break;
+                    case '\\': builder.Append("\\\\"); break;
+                    case '\n': builder.Append("\\n"); break;
+                    case '\r': builder.Append("\\r"); break;
+                    case '\t': builder.Append("\\t"); break;
+                    default: builder.Append(c); break;
+                }
+            }
+            builder.Append('"');
+            return builder.ToString();
+        }
+
         internal string HandleInvalidChars(string str)
         {
             char[] invalidChars = { '\r', '\n' };
@@ -668,6 +840,56 @@ namespace MICore
             return builder.ToString();
         }
 
+        /// <summary>
+        /// Escapes the operators of gdb's re_comp regular expressions (Emacs syntax, where '+' and '?' are operators
+        /// but '(', '|' and '{' are only operators after a backslash) so the text matches literally.
+        /// </summary>
+        public static string EscapeGdbRegex(string text)
+        {
+            StringBuilder builder = new StringBuilder(text.Length);
+            foreach (char c in text)
+            {
+                if (c == '\\' || c == '.' || c == '*' || c == '+' || c == '?' || c == '[' || c == ']' || c == '^' || c == '$')
+                {
+                    builder.Append('\\');
+                }
+                builder.Append(c);
+            }
+            return builder.ToString();
+        }
+
+        /// <summary>
+        /// Quotes a string as a python string literal, escaping everything outside of printable ascii. A surrogate pair
+        /// is escaped as the one character it encodes, as python would otherwise see two invalid characters.
+        /// </summary>
+        public static string ToPythonString(string str)
+        {
+            StringBuilder builder = new StringBuilder(str.Length + 2);
+            builder.Append('"');
+            for (int i = 0; i < str.Length; i++)
+            {
+                char c = str[i];
+                if (c == '"' || c == '\\')
+                {
+                    builder.Append('\\').Append(c);
+                }
+                else if (char.IsHighSurrogate(c) && i + 1 < str.Length && char.IsLowSurrogate(str[i + 1]))
+                {
+                    builder.AppendFormat(CultureInfo.InvariantCulture, "\\U{0:x8}", char.ConvertToUtf32(c, str[++i]));
+                }
+                else if (c < ' ' || c > '~')
+                {
+                    builder.AppendFormat(CultureInfo.InvariantCulture, "\\u{0:x4}", (int)c);
+                }
+                else
+                {
+                    builder.Append(c);
+                }
+            }
+            builder.Append('"');
+            return builder.ToString();
+        }
+
         #endregion
 
         #region Other
@@ -746,6 +968,15 @@ namespace MICore
             return Task.FromResult(new HashSet<string>());
         }
 
+        /// <summary>
+        /// True if the target is known to be little-endian. The engine only decodes values from raw target memory for
+        /// those targets.
+        /// </summary>
+        public virtual Task<bool> IsTargetLittleEndian()
+        {
+            return Task.FromResult(false);
+        }
+
         /// <summary>
         /// True if the underlying debugger excludes the printing of references to
         /// compound types when PrintValue.SimpleValues is used as an argument to
@@ -269,6 +269,97 @@ namespace MICore
 
         public override bool SupportsDataBreakpoints { get { return true; } }
 
+        public override bool SupportsDprintf { get { return true; } }
+
+        // Python source of the breakpoint type logpoints are inserted as. Its stop method prints the message with gdb.write
+        // and never stops. Values are formatted by gdb, so unlike dprintf arguments they don't allocate in the debuggee.
+        // Errors are printed in place of the value, and nothing escapes stop() as gdb stops on an exception there. gdb
+        // doesn't allow both a condition and a stop method on a breakpoint, so the condition is evaluated here as well.
+        private static readonly string[] s_logpointType =
+        {
+            "class MIEngineLogpoint(gdb.Breakpoint):",
+            "  def __init__(self, source, line, parts, cond, enabled):",
+            "    super(MIEngineLogpoint, self).__init__(source=source, line=line)",
+            "    self.parts = parts",
+            "    self.cond = cond",
+            "    self.enabled = enabled",
+            "  def stop(self):",
+            "    try:",
+            "      try:",
+            "        if self.cond and not bool(gdb.parse_and_eval(self.cond)):",
+            "          return False",
+            "      except gdb.error as e:",
+            "        gdb.write(\"<\" + str(e) + \">\" + chr(10))",
+            "        return False",
+            "      gdb.write(\"\".join(p if i % 2 == 0 else MIEngineLogpoint.value(p) for i, p in enumerate(self.parts)))",
+            "    except Exception:",
+            "      pass",
+            "    return False",
+            "  @staticmethod",
+            "  def value(part):",
+            "    try:",
+            "      if part == \"$FUNCTION\":",
+            "        return gdb.selected_frame().name() or \"<No Function Found>\"",
+            "      if part == \"$TID\":",
+            "        ptid = gdb.selected_thread().ptid",
+            "        return str(ptid[1] or ptid[2])",
+            "      if part == \"$PID\":",
+            "        return str(gdb.selected_inferior().pid)",
+            "      return str(gdb.parse_and_eval(part[1:-1]))",
+            "    except Exception as e:",
+            "      return \"<\" + str(e) + \">\"",
+            "def MIEngineLogpointCondition(number, cond):",
+            "  for b in gdb.breakpoints():",
+            "    if b.number == number:",
+            "      b.cond = cond",
+        };
+
+        public override async Task<bool> DefineLogpointType()
+        {
+            // The python command only takes a single line here, so exec the source with its newlines escaped
+            string python = "python exec('" + string.Join("\\n", s_logpointType) + "')";
+            Results results = await _debugger.CmdAsync("-interpreter-exec console " + ToCString(python), ResultClass.None);
+            return results.ResultClass == ResultClass.done;
+        }
+
+        public override async Task<Results> LogpointInsert(string filename, bool useUnixFormat, uint line, string? condition, bool enabled, IReadOnlyList<string> messageParts)
+        {
+            if (useUnixFormat)
+            {
+                filename = PlatformUtilities.WindowsPathToUnixPath(filename.Trim());
+            }
+            string python = string.Format(CultureInfo.InvariantCulture, "python gdb.write(str(MIEngineLogpoint({0}, {1}, [{2}], {3}, {4}).number))",
+                ToPythonString(filename), line, string.Join(", ", messageParts.Select(ToPythonString)),
+                IsNullOrWhiteSpace(condition) ? "None" : ToPythonString(condition!), enabled ? "True" : "False");
+            string output = await _debugger.ConsoleCmdAsync(python, allowWhileRunning: true, ignoreFailures: true);
+            string number = output.Split('\n').LastOrDefault(l => !IsNullOrWhiteSpace(l))?.Trim() ?? string.Empty;
+
+            TupleValue? bkpt = null;
+            if (int.TryParse(number, NumberStyles.None, CultureInfo.InvariantCulture, out _))
+            {
+                bkpt = await BreakInfo(number);
+            }
+            if (bkpt == null)
+            {
+                return new Results(ResultClass.error);
+            }
+            return new Results(ResultClass.done, new List<NamedResultValue> { new NamedResultValue("bkpt", bkpt) });
+        }
+
+        public override async Task LogpointCondition(string bkptno, string? expr)
+        {
+            string python = string.Format(CultureInfo.InvariantCulture, "python MIEngineLogpointCondition({0}, {1})",
+                bkptno, IsNullOrWhiteSpace(expr) ? "None" : ToPythonString(expr!));
+            await _debugger.CmdAsync("-interpreter-exec console " + ToCString(python), ResultClass.done);
+        }
+
+        public override async Task<bool> IsTargetLittleEndian()
+        {
+            // "The target endianness is set automatically (currently little endian)"
+            string result = await _debugger.ConsoleCmdAsync("show endian", allowWhileRunning: false, ignoreFailures: true);
+            return result != null && result.IndexOf("little endian", StringComparison.Ordinal) >= 0;
+        }
+
         public override string GetTargetArchitectureCommand()
         {
             return "show architecture";
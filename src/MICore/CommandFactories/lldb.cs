@@ -88,15 +88,11 @@ namespace MICore
             return results;
         }
         
-        public override async Task<Results> VarListChildren(string variableReference, enum_DEBUGPROP_INFO_FLAGS dwFlags, ResultClass resultClass = ResultClass.done)
+        protected override string GetVarListChildrenCommand(string variableReference, uint from, uint to)
         {
             // This override is necessary because lldb treats any object with children as not a simple object.
             // This prevents char* and char** from returning a value when queried by -var-list-children
-            // Limit the number of children expanded to 1000 in case memory is uninitialized
-            string command = string.Format(CultureInfo.InvariantCulture, "-var-list-children --all-values \"{0}\" 0 1000", variableReference);
-            Results results = await _debugger.CmdAsync(command, resultClass);
-
-            return results;
+            return string.Format(CultureInfo.InvariantCulture, "-var-list-children --all-values \"{0}\" {1} {2}", variableReference, from, to);
         }
 
         protected override async Task<Results> ThreadFrameCmdAsync(string command, string args, ResultClass exepctedResultClass, int threadId, uint frameLevel)
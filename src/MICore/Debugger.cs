@@ -34,10 +34,12 @@ namespace MICore
         public event EventHandler? DebuggerExitEvent;
         public event EventHandler<DebuggerAbortedEventArgs>? DebuggerAbortedEvent;
         public event EventHandler<string>? OutputStringEvent;
+        public event EventHandler<string>? ProgramOutputEvent;  // output of the program itself, raised as OutputStringEvent if this isn't handled
         public event EventHandler? EvaluationEvent;
         public event EventHandler? ErrorEvent;
         public event EventHandler? ModuleLoadEvent;  // occurs when stopped after a libraryLoadEvent
         public event EventHandler? LibraryLoadEvent; // a shared library was loaded
+        public event EventHandler? LibraryUnloadEvent; // a shared library was unloaded
         public event EventHandler? BreakChangeEvent; // a breakpoint was changed
         public event EventHandler? BreakCreatedEvent; // a breakpoint was created
         public event EventHandler? ThreadCreatedEvent;
@@ -611,6 +613,64 @@ namespace MICore
             }
         }
 
+        // Set once reading /proc/[pid]/mem has failed in a way that will not get better (ex: permissions)
+        private bool _directMemoryReadDisabled;
+
+        /// <summary>
+        /// Reads debuggee memory from /proc/[pid]/mem without going through the debugger. This is only done when
+        /// the user opted in, gdb is local on Linux, there is a single debuggee process and it is stopped.
+        /// </summary>
+        /// <returns>False if the memory could not be read this way and the caller should ask the debugger</returns>
+        protected bool TryReadProcessMemoryDirect(ulong address, uint count, byte[] bytes, out uint bytesRead)
+        {
+            bytesRead = 0;
+            if (!_launchOptions.DirectMemoryRead || _directMemoryReadDisabled || !PlatformUtilities.IsLinux() ||
+                !IsLocalGdbTarget() || IsCoreDump || ProcessState != ProcessState.Stopped || address > long.MaxValue)
+            {
+                return false;
+            }
+
+            int pid;
+            lock (_debuggeePids)
+            {
+                if (_debuggeePids.Count != 1)
+                {
+                    return false;
+                }
+                pid = _debuggeePids.First().Value;
+            }
+
+            try
+            {
+                using (var stream = new System.IO.FileStream("/proc/" + pid.ToString(CultureInfo.InvariantCulture) + "/mem", System.IO.FileMode.Open, System.IO.FileAccess.Read, System.IO.FileShare.ReadWrite, bufferSize: 1))
+                {
+                    stream.Position = (long)address;
+                    while (bytesRead < count)
+                    {
+                        int read = stream.Read(bytes, (int)bytesRead, (int)(count - bytesRead));
+                        if (read <= 0)
+                        {
+                            break;
+                        }
+                        bytesRead += (uint)read;
+                    }
+                }
+                return bytesRead == count;
+            }
+            catch (UnauthorizedAccessException e)
+            {
+                // ptrace access mode checks refuse us, for example when attached to a process which is not our descendant
+                Logger.WriteLine(LogLevel.Verbose, "Direct memory read disabled: " + e.Message);
+                _directMemoryReadDisabled = true;
+                return false;
+            }
+            catch (System.IO.IOException)
+            {
+                // Part of the range is not mapped, let the debugger report what is readable
+                return false;
+            }
+        }
+
         /// <summary>
         /// Flag to indicate that '-exec-interrupt' was used for async-break scenarios.
         /// </summary>
@@ -886,6 +946,38 @@ namespace MICore
             }
         }
 
+        /// <summary>
+        /// Sends a group of independent commands to the debugger back-to-back instead of waiting for each reply
+        /// before sending the next command. Replies are matched to commands by their token, so the results are
+        /// returned in the same order as the commands.
+        /// </summary>
+        /// <param name="commands">Commands which do not depend on each other's results or side effects</param>
+        /// <param name="expectedResultClass">Result class expected from every command</param>
+        public async Task<Results[]> CmdBatchAsync(IReadOnlyList<string> commands, ResultClass expectedResultClass)
+        {
+            if (commands.Count == 0)
+            {
+                return Array.Empty<Results>();
+            }
+
+            await _commandLock.AquireShared();
+
+            try
+            {
+                var tasks = new Task<Results>[commands.Count];
+                for (int i = 0; i < commands.Count; i++)
+                {
+                    tasks[i] = CmdAsyncInternal(commands[i], expectedResultClass);
+                }
+
+                return await Task.WhenAll(tasks);
+            }
+            finally
+            {
+                _commandLock.ReleaseShared();
+            }
+        }
+
         public Task<Results> ExclusiveCmdAsync(string command, ResultClass expectedResultClass, ExclusiveLockToken exclusiveLockToken)
         {
             if (ExclusiveLockToken.IsNullOrClosed(exclusiveLockToken))
@@ -1288,9 +1380,11 @@ namespace MICore
                 switch (c)
                 {
                     case '~':
-                    case '@':
                         OnDebuggeeOutput(noprefix);         // Console stream
                         break;
+                    case '@':
+                        OnDebuggeeOutput(noprefix, isProgramOutput: true);  // Target stream
+                        break;
                     case '^':
                         OnResult(noprefix, token);
                         break;
@@ -1304,8 +1398,8 @@ namespace MICore
                         OnNotificationOutput(noprefix);
                         break;
                     default:
-                        // Token is not prepended, use original line.
-                        OnDebuggeeOutput(originalLine + '\n');
+                        // Token is not prepended, use original line. This is the program writing to the debugger's terminal.
+                        OnDebuggeeOutput(originalLine + '\n', isProgramOutput: true);
                         break;
                 }
             }
@@ -1341,13 +1435,17 @@ namespace MICore
             }
         }
 
-        private void OnDebuggeeOutput(string cmd)
+        private void OnDebuggeeOutput(string cmd, bool isProgramOutput = false)
         {
             string decodedOutput = _miResults.ParseCString(cmd);
 
             if (_consoleCommandOutput == null)
             {
-                if (OutputStringEvent != null)
+                if (isProgramOutput && ProgramOutputEvent != null)
+                {
+                    ProgramOutputEvent(this, decodedOutput);
+                }
+                else if (OutputStringEvent != null)
                 {
                     OutputStringEvent(this, decodedOutput);
                 }
@@ -1426,6 +1524,11 @@ namespace MICore
                     LibraryLoadEvent(this, new ResultEventArgs(results));
                 }
             }
+            else if (cmd.StartsWith("library-unloaded,", StringComparison.Ordinal))
+            {
+                results = _miResults.ParseResultList(cmd.Substring("library-unloaded,".Length));
+                LibraryUnloadEvent?.Invoke(this, new ResultEventArgs(results));
+            }
             else if (cmd.StartsWith("breakpoint-modified,", StringComparison.Ordinal))
             {
                 results = _miResults.ParseResultList(cmd.Substring(20));
@@ -127,6 +127,18 @@ namespace MICore.Json.LaunchOptions
         /// </summary>
         [JsonProperty("debuginfod", DefaultValueHandling = DefaultValueHandling.Ignore)]
         public DebuginfodSettings? Debuginfod { get; set; }
+
+        /// <summary>
+        /// If true and GDB is running on the local Linux machine, memory is read directly from /proc/&lt;pid&gt;/mem while the process is stopped instead of through GDB. Default is false.
+        /// </summary>
+        [JsonProperty("directMemoryRead", DefaultValueHandling = DefaultValueHandling.Ignore)]
+        public bool? DirectMemoryRead { get; set; }
+
+        /// <summary>
+        /// Limits how much program output is forwarded to the debug console. Example: "outputThrottling": { "maxLinesPerSecond": 1000, "logFile": "/tmp/output.txt" }.
+        /// </summary>
+        [JsonProperty("outputThrottling", DefaultValueHandling = DefaultValueHandling.Ignore)]
+        public OutputThrottlingSettings? OutputThrottling { get; set; }
     }
 
     internal class VisualizerFileConverter : JsonConverter
@@ -262,6 +274,13 @@ namespace MICore.Json.LaunchOptions
         [JsonProperty("exceptionList", DefaultValueHandling = DefaultValueHandling.Ignore)]
         public string? ExceptionList { get; set; }
 
+        /// <summary>
+        /// If true, symbols for a lib are loaded the first time one of its functions is seen on a stack, instead of when the lib loads.
+        /// Libs that match ExceptionList are still loaded up front. Overrides LoadAll. Default value is false.
+        /// </summary>
+        [JsonProperty("loadOnDemand", DefaultValueHandling = DefaultValueHandling.Ignore)]
+        public bool? LoadOnDemand { get; set; }
+
         #endregion
 
         #region Constructors
@@ -322,6 +341,21 @@ namespace MICore.Json.LaunchOptions
         Stop
     }
 
+    public partial class OutputThrottlingSettings
+    {
+        /// <summary>
+        /// Maximum number of lines of program output forwarded per second. Lines beyond it are dropped and counted. Default is 0, for no limit.
+        /// </summary>
+        [JsonProperty("maxLinesPerSecond", DefaultValueHandling = DefaultValueHandling.Ignore)]
+        public int? MaxLinesPerSecond { get; set; }
+
+        /// <summary>
+        /// If set, all program output, including dropped lines, is also written to this file.
+        /// </summary>
+        [JsonProperty("logFile", DefaultValueHandling = DefaultValueHandling.Ignore)]
+        public string? LogFile { get; set; }
+    }
+
     public partial class DebuginfodSettings
     {
         /// <summary>
@@ -1041,6 +1041,20 @@ namespace MICore
             }
         }
 
+        private bool _siLoadOnDemand;
+        /// <summary>
+        /// If true then load symbols for a library when one of its frames first appears on a stack
+        /// </summary>
+        public bool SymbolInfoLoadOnDemand
+        {
+            get { return _siLoadOnDemand; }
+            set
+            {
+                VerifyCanModifyProperty(nameof(SymbolInfoLoadOnDemand));
+                _siLoadOnDemand = value;
+            }
+        }
+
         /// <summary>
         /// Check is it is Ok to let the debugger load symbols on solib events without intervention
         /// </summary>
@@ -1277,6 +1291,52 @@ namespace MICore
             }
         }
 
+        private bool _directMemoryRead = false;
+
+        /// <summary>
+        /// If true, memory reads of a stopped process debugged by a local gdb on Linux are served from
+        /// /proc/[pid]/mem instead of '-data-read-memory-bytes'. Default is false.
+        /// </summary>
+        public bool DirectMemoryRead
+        {
+            get { return _directMemoryRead; }
+            set
+            {
+                VerifyCanModifyProperty(nameof(DirectMemoryRead));
+                _directMemoryRead = value;
+            }
+        }
+
+        private int _outputMaxLinesPerSecond;
+
+        /// <summary>
+        /// Maximum number of lines of program output forwarded to the IDE per second, or 0 for no limit.
+        /// </summary>
+        public int OutputMaxLinesPerSecond
+        {
+            get { return _outputMaxLinesPerSecond; }
+            set
+            {
+                VerifyCanModifyProperty(nameof(OutputMaxLinesPerSecond));
+                _outputMaxLinesPerSecond = value;
+            }
+        }
+
+        private string? _outputLogFile;
+
+        /// <summary>
+        /// File which receives all program output, including lines dropped by <see cref="OutputMaxLinesPerSecond"/>. Optional.
+        /// </summary>
+        public string? OutputLogFile
+        {
+            get { return _outputLogFile; }
+            set
+            {
+                VerifyCanModifyProperty(nameof(OutputLogFile));
+                _outputLogFile = value;
+            }
+        }
+
         /// <summary>
         /// Returns environment entries to configure debuginfod on the GDB process.
         /// </summary>
@@ -1927,7 +1987,8 @@ namespace MICore
 
             if (options.SymbolLoadInfo != null)
             {
-                SymbolInfoLoadAll = options.SymbolLoadInfo.LoadAll.GetValueOrDefault(true);
+                SymbolInfoLoadOnDemand = options.SymbolLoadInfo.LoadOnDemand.GetValueOrDefault(false);
+                SymbolInfoLoadAll = !SymbolInfoLoadOnDemand && options.SymbolLoadInfo.LoadAll.GetValueOrDefault(true);
 
                 if (!IsNullOrWhiteSpace(options.SymbolLoadInfo.ExceptionList))
                 {
@@ -1960,6 +2021,9 @@ namespace MICore
             this.EnableDebuginfod = options.Debuginfod?.Enabled ?? false;
             int debuginfodTimeout = options.Debuginfod?.Timeout ?? 30;
             this.DebuginfodTimeout = debuginfodTimeout >= 0 ? debuginfodTimeout : 30;
+            this.DirectMemoryRead = options.DirectMemoryRead.GetValueOrDefault(false);
+            this.OutputMaxLinesPerSecond = Math.Max(options.OutputThrottling?.MaxLinesPerSecond ?? 0, 0);
+            this.OutputLogFile = options.OutputThrottling?.LogFile;
         }
 
         protected void InitializeCommonOptions(Xml.LaunchOptions.BaseLaunchOptions source)
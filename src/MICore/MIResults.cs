@@ -223,11 +223,48 @@ namespace MICore
 
     public class ConstValue : ResultValue
     {
-        public readonly string Content;
+        private string? _content;
+
+        // When created by the parser, the value is a view over the still-encoded c-string in the original
+        // MI line. It is only decoded (and the line released) the first time Content is read.
+        private string? _source;
+        private readonly int _start;
+        private readonly int _length;
 
         public ConstValue(string str)
         {
-            Content = str ?? string.Empty;
+            _content = str ?? string.Empty;
+        }
+
+        /// <summary>
+        /// Creates a lazily decoded value over the body of a c-string (without the enclosing quotes).
+        /// </summary>
+        internal ConstValue(string source, int start, int length)
+        {
+            _source = source;
+            _start = start;
+            _length = length;
+        }
+
+        public string Content
+        {
+            get
+            {
+                string? content = _content;
+                if (content == null)
+                {
+                    string? source = _source;
+                    if (source == null)
+                    {
+                        // another thread decoded the value between the two reads
+                        return _content!;
+                    }
+                    content = MIResults.DecodeCString(source, _start, _length);
+                    _content = content;
+                    _source = null;
+                }
+                return content;
+            }
         }
 
         public ulong ToAddr
@@ -370,7 +407,7 @@ namespace MICore
         }
         public override ResultValue Find(string name)
         {
-            var item = Content.Find((c) => c.Name == name);
+            var item = FindItem(name);
             if (item == null)
             {
                 throw new MIResultFormatException(name, this);
@@ -378,10 +415,28 @@ namespace MICore
             return item.Value;
         }
 
+        public override bool TryFind(string name, [NotNullWhen(true)] out ResultValue? result)
+        {
+            result = FindItem(name)?.Value;
+            return result is not null;
+        }
+
         public override bool Contains(string name)
         {
-            var item = Content.Find((c) => c.Name == name);
-            return item != null;
+            return FindItem(name) != null;
+        }
+
+        private NamedResultValue? FindItem(string name)
+        {
+            // Names produced by the parser are interned, so the reference check in string equality usually decides
+            for (int i = 0; i < Content.Count; i++)
+            {
+                if (Content[i].Name == name)
+                {
+                    return Content[i];
+                }
+            }
+            return null;
         }
 
         public override string ToString()
@@ -500,7 +555,7 @@ namespace MICore
         }
         public override ResultValue Find(string name)
         {
-            var item = Array.Find(Content, (c) => c.Name == name);
+            var item = FindItem(name);
             if (item == null)
             {
                 throw new MIResultFormatException(name, this);
@@ -508,10 +563,27 @@ namespace MICore
             return item.Value;
         }
 
+        public override bool TryFind(string name, [NotNullWhen(true)] out ResultValue? result)
+        {
+            result = FindItem(name)?.Value;
+            return result is not null;
+        }
+
         public override bool Contains(string name)
         {
-            var item = Array.Find(Content, (c) => c.Name == name);
-            return item != null;
+            return FindItem(name) != null;
+        }
+
+        private NamedResultValue? FindItem(string name)
+        {
+            for (int i = 0; i < Content.Length; i++)
+            {
+                if (Content[i].Name == name)
+                {
+                    return Content[i];
+                }
+            }
+            return null;
         }
 
         public ResultValue[] FindAll(string name)
@@ -682,6 +754,40 @@ namespace MICore
             }
         }
 
+        /// <summary>
+        /// Bounded, lock-free cache of the result names seen on MI lines. The vocabulary of names gdb uses is small
+        /// ("frame", "addr", "name", ...), so this lets the parser hand out a shared string instead of allocating
+        /// a new one per result. Collisions just replace the slot.
+        /// </summary>
+        private class NameTable
+        {
+            private const int Size = 1024; // must be a power of two
+            private readonly string?[] _slots = new string?[Size];
+
+            public string GetOrAdd(string source, int start, int length)
+            {
+                uint hash = 2166136261;
+                for (int i = start; i < start + length; i++)
+                {
+                    hash = (hash ^ source[i]) * 16777619;
+                }
+
+                int slot = (int)(hash & (Size - 1));
+                string? name = _slots[slot];
+                if (name != null && name.Length == length && string.CompareOrdinal(name, 0, source, start, length) == 0)
+                {
+                    return name;
+                }
+
+                name = source.Substring(start, length);
+                _slots[slot] = name;
+                return name;
+            }
+        }
+
+        private static readonly NameTable s_nameTable = new NameTable();
+        private static readonly char[] s_cstringSpecialChars = { '\\', '\"' };
+
         private Logger Logger { get; set; }
 
         public MIResults(Logger logger)
@@ -702,11 +808,11 @@ namespace MICore
             if (comma < 0)
             {
                 // no comma, so entire string should be the result class
-                results = new Results(ParseResultClass(output), new List<NamedResultValue>());
+                results = new Results(ParseResultClass(resultString, resultString.Length), new List<NamedResultValue>());
             }
             else
             {
-                resultClass = ParseResultClass(output.Substring(0, comma));
+                resultClass = ParseResultClass(resultString, comma);
                 Span wholeString = new Span(resultString);
                 results = ParseResultList(resultString, wholeString.AdvanceTo(comma + 1), resultClass);
             }
@@ -722,13 +828,7 @@ namespace MICore
         private Results ParseResultList(string resultString, Span listStr, ResultClass resultClass = ResultClass.None)
         {
             Span rest;
-            var list = ParseResultList(resultString, (Span s, ref int i) =>
-                {
-                    return true;
-                }, (Span s, ref int i) =>
-                    {
-                        return i == s.Extent;
-                    }, listStr, out rest);
+            var list = ParseResultList(resultString, NoDelimiter, NoDelimiter, listStr, out rest);
 
             Results results = new Results(resultClass, list);
 
@@ -764,6 +864,56 @@ namespace MICore
             return s == null ? string.Empty : s.AsString;
         }
 
+        /// <summary>
+        /// Decodes the body of a c-string (the characters between the enclosing quotes) from an MI line.
+        /// </summary>
+        internal static string DecodeCString(string source, int start, int length)
+        {
+            int end = start + length;
+            int firstSpecial = source.IndexOfAny(s_cstringSpecialChars, start, length);
+            if (firstSpecial < 0)
+            {
+                // Most values contain no escapes, so they are a simple slice of the line
+                return length == 0 ? string.Empty : source.Substring(start, length);
+            }
+
+            StringBuilder output = new StringBuilder(length);
+            output.Append(source, start, firstSpecial - start);
+            for (int i = firstSpecial; i < end; i++)
+            {
+                char c = source[i];
+                if (c == '\"')
+                {
+                    // the scanner only lets doubled quotes through, emit a single quote
+                    i++;
+                }
+                else if (c == '\\' && i + 1 < end)
+                {
+                    // escaped character
+                    c = source[++i];
+                    switch (c)
+                    {
+                        case 'n': c = '\n'; break;
+                        case 'r': c = '\r'; break;
+                        case 't': c = '\t'; break;
+                        default:
+                            if (c >= '0' && c <= '3')
+                            {
+                                i = i - 1;
+                                if (SpanOctalChars(source, end, ref i, output))
+                                {
+                                    continue;   // handled the output of the octal-encoded chars
+                                }
+                                c = source[i]; // just emit the '\\'
+                            }
+                            break;
+                    }
+                }
+                output.Append(c);
+            }
+            return output.ToString();
+        }
+
         /// <summary>
         /// value ==>const | tuple | list
         /// </summary>
@@ -843,7 +993,7 @@ namespace MICore
                 ParseError(resultString, "variable not found", resultStr);
                 return null;
             }
-            string name = resultStr.Prefix(equals).Extract(resultString);
+            string name = s_nameTable.GetOrAdd(resultString, resultStr.Start, equals);
             ResultValue? value = ParseResultValue(resultString, resultStr.Advance(equals + 1), out rest);
             if (value == null)
             {
@@ -852,27 +1002,43 @@ namespace MICore
             return new NamedResultValue(name, value);
         }
 
-        private static ResultClass ParseResultClass(string resultClass)
+        private static ResultClass ParseResultClass(string resultString, int length)
         {
-            switch (resultClass)
+            if (IsResultClass(resultString, length, "done"))
             {
-                case "done": return ResultClass.done;
-                case "running": return ResultClass.running;
-                case "connected": return ResultClass.connected;
-                case "error": return ResultClass.error;
-                case "exit": return ResultClass.exit;
-                default:
-                    {
-                        Debug.Fail("unexpected result class");
-                        return ResultClass.None;
-                    }
+                return ResultClass.done;
+            }
+            if (IsResultClass(resultString, length, "running"))
+            {
+                return ResultClass.running;
+            }
+            if (IsResultClass(resultString, length, "connected"))
+            {
+                return ResultClass.connected;
+            }
+            if (IsResultClass(resultString, length, "error"))
+            {
+                return ResultClass.error;
             }
+            if (IsResultClass(resultString, length, "exit"))
+            {
+                return ResultClass.exit;
+            }
+            Debug.Fail("unexpected result class");
+            return ResultClass.None;
+        }
+
+        private static bool IsResultClass(string resultString, int length, string resultClass)
+        {
+            return length == resultClass.Length && string.CompareOrdinal(resultString, 0, resultClass, 0, length) == 0;
         }
 
+        /// <summary>
+        /// Locates the extent of a c-string. The value is not decoded here, see <see cref="DecodeCString"/>.
+        /// </summary>
         private ConstValue? ParseCString(string resultString, Span input, out Span rest)
         {
             rest = input;
-            StringBuilder output = new StringBuilder();
             if (input.IsEmpty || resultString[input.Start] != '\"')
             {
                 ParseError(resultString, "Cstring expected", input);
@@ -887,11 +1053,10 @@ namespace MICore
                 if (c == '\"')
                 {
                     // closing quote, so we are (probably) done
-                    i++;
-                    if ((i < input.Extent) && (resultString[i] == c))
+                    if ((i + 1 < input.Extent) && (resultString[i + 1] == c))
                     {
-                        // double quotes mean we emit a single quote, and carry on
-                        ;
+                        // double quotes mean a single quote in the value, and carry on
+                        i++;
                     }
                     else
                     {
@@ -901,51 +1066,35 @@ namespace MICore
                 }
                 else if (c == '\\')
                 {
-                    // escaped character
-                    c = resultString[++i];
-                    switch (c)
-                    {
-                        case 'n': c = '\n'; break;
-                        case 'r': c = '\r'; break;
-                        case 't': c = '\t'; break;
-                        default:
-                            if (c >= '0' && c <= '3')
-                            {
-                                i = i - 1;
-                                if (SpanOctalChars(resultString, ref i, output))
-                                {
-                                    continue;   // handled the output of the octal-encoded chars
-                                }
-                                c = resultString[i]; // just emit the '\\'
-                            }
-                            break;
-                    }
+                    // skip the escaped character
+                    i++;
                 }
-                output.Append(c);
             }
             if (!endFound)
             {
                 ParseError(resultString, "CString not terminated", input);
                 return null;
             }
-            rest = input.AdvanceTo(i);
-            return new ConstValue(output.ToString());
+            int bodyStart = input.Start + 1;
+            rest = input.AdvanceTo(i + 1);
+            return new ConstValue(resultString, bodyStart, i - bodyStart);
         }
 
         /// <summary>
         /// convert a string of octal encode bytes into chars using an utf8 decoder and write resulting chars to output
         /// </summary>
         /// <param name="str"></param>
+        /// <param name="end">index just past the last character which may be consumed</param>
         /// <param name="i"></param>
         /// <param name="output"></param>
         /// <returns></returns>
-        bool SpanOctalChars(string str, ref int i, StringBuilder output)
+        private static bool SpanOctalChars(string str, int end, ref int i, StringBuilder output)
         {
             int s = i;
             bool error = false;
             int cChars = 0;
-            byte[] bytes = new byte[str.Length];
-            while (!error && i + 3 < str.Length && str[i] == '\\' && str[i+1] >= '0' && str[i+1] <= '3')
+            byte[] bytes = new byte[(end - i) / 4];
+            while (!error && i + 3 < end && str[i] == '\\' && str[i+1] >= '0' && str[i+1] <= '3')
             {
                 int v = 0;
                 for (int n = 1; n <= 3; ++n)
@@ -972,27 +1121,35 @@ namespace MICore
             }
             char[] chars = new char[cChars];
             int cCount = Encoding.UTF8.GetDecoder().GetChars(bytes, 0, cChars, chars, 0);
-            for (int j = 0; j < cCount; ++j)
-            {
-                output.Append(chars[j]);
-            }
+            output.Append(chars, 0, cCount);
             --i;
             return true;
         }
 
-        private delegate bool EdgeCondition(Span s, ref int i);
+        /// <summary>
+        /// Passed as the begin/end character of a result list which is not enclosed in brackets (the top level list).
+        /// </summary>
+        private const char NoDelimiter = '\0';
 
-        private List<NamedResultValue>? ParseResultList(string resultString, EdgeCondition begin, EdgeCondition end, Span input, out Span rest)
+        /// <summary>
+        /// Parses result ( "," result )* enclosed in the begin and end characters. Pass <see cref="NoDelimiter"/>
+        /// for a list that runs to the end of the input.
+        /// </summary>
+        private List<NamedResultValue>? ParseResultList(string resultString, char begin, char end, Span input, out Span rest)
         {
             rest = Span.Empty;
             List<NamedResultValue> list = new List<NamedResultValue>();
             int i = input.Start;
-            if (!begin(input, ref i))
+            if (begin != NoDelimiter)
             {
-                ParseError(resultString, "Unexpected opening character", input);
-                return null;
+                if (resultString[i] != begin)
+                {
+                    ParseError(resultString, "Unexpected opening character", input);
+                    return null;
+                }
+                i++;
             }
-            if (end(input, ref i))    // tuple is empty
+            if (IsListEnd(resultString, end, input, ref i))    // tuple is empty
             {
                 rest = input.AdvanceTo(i);  // eat through the closing brace
                 return list;
@@ -1019,7 +1176,7 @@ namespace MICore
             }
 
             i = input.Start;
-            if (!end(input, ref i))    // tuple is not closed
+            if (!IsListEnd(resultString, end, input, ref i))    // tuple is not closed
             {
                 ParseError(resultString, "Unexpected list termination", input);
                 rest = Span.Empty;
@@ -1029,25 +1186,18 @@ namespace MICore
             return list;
         }
 
-        private List<NamedResultValue>? ParseResultList(string resultString, char begin, char end, Span input, out Span rest)
+        private static bool IsListEnd(string resultString, char end, Span s, ref int i)
         {
-            return ParseResultList(resultString, (Span s, ref int i) =>
+            if (end == NoDelimiter)
             {
-                if (resultString[i] == begin)
-                {
-                    i++;
-                    return true;
-                }
-                return false;
-            }, (Span s, ref int i) =>
+                return i == s.Extent;
+            }
+            if (i < s.Extent && resultString[i] == end)
             {
-                if (i < s.Extent && resultString[i] == end)
-                {
-                    i++;
-                    return true;
-                }
-                return false;
-            }, input, out rest);
+                i++;
+                return true;
+            }
+            return false;
         }
 
         /// <summary>
@@ -0,0 +1,33 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using MICore;
+using Xunit;
+
+namespace MICoreUnitTests
+{
+    public class MICommandFactoryTests
+    {
+        [Fact]
+        public void EscapeGdbRegex()
+        {
+            Assert.Equal(@"/usr/lib/x86_64-linux-gnu/libstdc\+\+\.so\.6", MICommandFactory.EscapeGdbRegex("/usr/lib/x86_64-linux-gnu/libstdc++.so.6"));
+            Assert.Equal(@"/opt/a\?b/lib\[1\]\*\.so", MICommandFactory.EscapeGdbRegex("/opt/a?b/lib[1]*.so"));
+            Assert.Equal(@"C:\\lib\^\$\.dll", MICommandFactory.EscapeGdbRegex(@"C:\lib^$.dll"));
+
+            // only operators in Emacs syntax when preceded by a backslash
+            Assert.Equal(@"/opt/lib(x)|{1}\.so", MICommandFactory.EscapeGdbRegex("/opt/lib(x)|{1}.so"));
+        }
+
+        [Fact]
+        public void ToPythonString()
+        {
+            Assert.Equal(@"""x = \""{x}\"" \\n""", MICommandFactory.ToPythonString(@"x = ""{x}"" \n"));
+            Assert.Equal(@"""tab\u0009caf\u00e9\u000a""", MICommandFactory.ToPythonString("tab\tcaf\u00e9\n"));
+
+            // a character outside the BMP is one python character, not two lone surrogates
+            Assert.Equal(@"""smile \U0001f600!""", MICommandFactory.ToPythonString("smile \U0001F600!"));
+            Assert.Equal(@"""\ud83d""", MICommandFactory.ToPythonString("\ud83d"));
+        }
+    }
+}
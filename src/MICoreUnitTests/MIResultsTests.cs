@@ -87,5 +87,39 @@ namespace MICoreUnitTests
             Assert.Equal("value1", results.FindString("name1"));
             Assert.Equal("value2", results.FindString("name2"));
         }
+
+        [Fact]
+        public void TestParseCommandOutputEscapedValues()
+        {
+            MIResults r = new MIResults(null);
+            // done,value="\"hi\" \\ \t\303\251",msg="a ""quoted"" word"
+            string miString = @"done,value=""\""hi\"" \\ \t\303\251"",msg=""a """"quoted"""" word""";
+            Results results = r.ParseCommandOutput(miString);
+
+            Assert.Equal(ResultClass.done, results.ResultClass);
+            Assert.Equal("\"hi\" \\ \t\u00e9", results.FindString("value"));
+            Assert.Equal("a \"quoted\" word", results.FindString("msg"));
+        }
+
+        [Fact]
+        public void TestParseCommandOutputNestedValues()
+        {
+            MIResults r = new MIResults(null);
+            string miString = @"done,stack=[frame={level=""0"",addr=""0x1000"",func=""main""},frame={level=""1"",addr=""0x2000"",func=""start""}]";
+            Results results = r.ParseCommandOutput(miString);
+
+            ResultListValue stack = results.Find<ResultListValue>("stack");
+            TupleValue[] frames = stack.FindAll<TupleValue>("frame");
+            Assert.Equal(2, frames.Length);
+            Assert.Equal(1, frames[1].FindInt("level"));
+            Assert.Equal(0x2000u, frames[1].FindAddr("addr"));
+            Assert.Equal("start", frames[1].FindString("func"));
+            Assert.True(frames[0].TryFind("func", out ResultValue func));
+            Assert.Equal("main", func.ToString());
+            Assert.False(frames[0].Contains("file"));
+
+            // names are shared between the results of a line
+            Assert.Same(frames[0].Content[0].Name, frames[1].Content[0].Name);
+        }
     }
 }
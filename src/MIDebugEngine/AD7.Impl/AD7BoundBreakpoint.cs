@@ -219,7 +219,7 @@ namespace Microsoft.MIDebugEngine
 
         /// <summary>
         /// Re-sends -break-after to GDB after a pass count breakpoint fires.
-        /// MOD: skips passCount-1 hits. EQUAL: clears the ignore count.
+        /// MOD: skips passCount-1 hits. EQUAL: ignores every later hit, so they don't stop the process only for the engine to continue it.
         /// </summary>
         internal async Task RearmBreakAfterAsync()
         {
@@ -231,7 +231,7 @@ namespace Microsoft.MIDebugEngine
                     ignoreCount = _passCountValue - 1;
                     break;
                 case enum_BP_PASSCOUNT_STYLE.BP_PASSCOUNT_EQUAL:
-                    ignoreCount = 0;
+                    ignoreCount = AD7PendingBreakpoint.IgnoreAllHits;
                     break;
                 default:
                     return;
@@ -4,6 +4,7 @@
 using MICore;
 using Microsoft.DebugEngineHost;
 using Microsoft.VisualStudio.Debugger.Interop;
+using Microsoft.VisualStudio.Debugger.Interop.DAP;
 using System;
 using System.Collections.Generic;
 using System.Diagnostics;
@@ -40,6 +41,7 @@ namespace Microsoft.MIDebugEngine
         private ulong _codeAddress = 0;
         private uint _size = 0;
         private IEnumerable<Checksum> _checksums = null;
+        private readonly Logpoint _logpoint;    // the log message the debugger prints, or null if this isn't a logpoint or it has to stop
 
         public DebuggedProcess DebuggedProcess { get { return _engine.DebuggedProcess; } }
 
@@ -80,6 +82,11 @@ namespace Microsoft.MIDebugEngine
 
             _bp = null;    // no underlying breakpoint created yet
             _BPError = null;
+
+            if (pBPRequest is IDebugBreakpointRequestDAP dapRequest && dapRequest.GetLogMessage(out string[] logMessageParts) == Constants.S_OK)
+            {
+                _logpoint = Logpoint.Compile(logMessageParts);
+            }
         }
 
         private bool VerifyCondition(BP_CONDITION request)
@@ -336,7 +343,20 @@ namespace Microsoft.MIDebugEngine
                 // Bind all breakpoints that match this source and line number.
                 if (_documentName != null)
                 {
-                    bindResult = await PendingBreakpoint.Bind(_documentName, _startPosition[0].dwLine + 1, _startPosition[0].dwColumn, _engine.DebuggedProcess, _condition, _enabled, _checksums, this);
+                    bindResult = null;
+                    if (await CanBindAsLogpoint())
+                    {
+                        bindResult = await PendingBreakpoint.Bind(_documentName, _startPosition[0].dwLine + 1, _engine.DebuggedProcess, _condition, _enabled, _logpoint, this);
+                        if (bindResult.PendingBreakpoint == null)
+                        {
+                            // The debugger rejected the logpoint, so log the message from a stopping breakpoint instead
+                            bindResult = null;
+                        }
+                    }
+                    if (bindResult == null)
+                    {
+                        bindResult = await PendingBreakpoint.Bind(_documentName, _startPosition[0].dwLine + 1, _startPosition[0].dwColumn, _engine.DebuggedProcess, _condition, _enabled, _checksums, this);
+                    }
                 }
                 else if (_functionName != null)
                 {
@@ -399,6 +419,40 @@ namespace Microsoft.MIDebugEngine
             }
         }
 
+        /// <summary>
+        /// A logpoint at a source line is inserted as a breakpoint that doesn't stop when the debugger can print its
+        /// message by itself.
+        /// </summary>
+        private async Task<bool> CanBindAsLogpoint()
+        {
+            if (_logpoint == null || IsHardwareBreakpoint || !_engine.DebuggedProcess.MICommandFactory.SupportsDprintf)
+            {
+                return false;
+            }
+            // Neither dprintf nor python breakpoints take the source checksums a breakpoint is matched with
+            if (_checksums != null && _checksums.Any())
+            {
+                return false;
+            }
+            if (_logpoint.IsPlainText)
+            {
+                return true;
+            }
+            // A python stop method runs before gdb applies the ignore count, so hit conditions need the stopping breakpoint
+            if ((_bpRequestInfo.dwFields & enum_BPREQI_FIELDS.BPREQI_PASSCOUNT) != 0
+                && _bpRequestInfo.bpPassCount.stylePassCount != enum_BP_PASSCOUNT_STYLE.BP_PASSCOUNT_NONE)
+            {
+                return false;
+            }
+            return await _engine.DebuggedProcess.EnsureLogpointType();
+        }
+
+        /// <summary>
+        /// Ignore count that keeps GDB from ever stopping at the breakpoint again while still counting its hits,
+        /// e.g. once an "== N" hit condition has been met. GDB's ignore counts are ints.
+        /// </summary>
+        internal const uint IgnoreAllHits = int.MaxValue;
+
         /// <summary>
         /// Computes the ignore count for -break-after, accounting for hits already
         /// counted from a prior breakpoint (<paramref name="currentHits"/>).
@@ -413,6 +467,12 @@ namespace Microsoft.MIDebugEngine
             switch (style)
             {
                 case enum_BP_PASSCOUNT_STYLE.BP_PASSCOUNT_EQUAL:
+                    // Hit N has already gone by, so this breakpoint never stops again.
+                    if (currentHits >= passCount)
+                    {
+                        return IgnoreAllHits;
+                    }
+                    return passCount - 1 - currentHits;
                 case enum_BP_PASSCOUNT_STYLE.BP_PASSCOUNT_EQUAL_OR_GREATER:
                     // Need to stop at hit N. Already counted currentHits, so skip (N - 1 - currentHits) more.
                     return passCount - 1 > currentHits ? passCount - 1 - currentHits : 0;
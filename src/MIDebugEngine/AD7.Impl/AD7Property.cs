@@ -8,6 +8,7 @@ using System.Linq;
 using System.Runtime.InteropServices;
 using Microsoft.MIDebugEngine.Natvis;
 using Microsoft.VisualStudio.Debugger.Interop;
+using Microsoft.VisualStudio.Debugger.Interop.DAP;
 using Microsoft.VisualStudio.Debugger.Interop.MI;
 
 namespace Microsoft.MIDebugEngine
@@ -17,7 +18,7 @@ namespace Microsoft.MIDebugEngine
     // The property is usually the result of an expression evaluation. 
     //
     // The sample engine only supports locals and parameters for functions that have symbols loaded.
-    internal class AD7Property : IDebugProperty3, IDebugProperty160, IDebugMIEngineProperty
+    internal class AD7Property : IDebugProperty3, IDebugProperty160, IDebugMIEngineProperty, IDebugPropertyDAP
     {
         private static uint s_maxChars = 1000000;
         private byte[] _bytes;
@@ -547,6 +548,52 @@ namespace Microsoft.MIDebugEngine
             ppExpressionContext = new AD7StackFrame(_engine, _variableInformation.Client, _variableInformation.ThreadContext);
             return Constants.S_OK;
         }
+
+        #region IDebugPropertyDAP Members
+
+        // Arrays without a visualizer can be expanded a range of elements at a time, a visualizer decides its own children
+        private VariableInformation IndexedVariable
+        {
+            get
+            {
+                VariableInformation variable = _variableInformation as VariableInformation;
+                if (variable == null || variable.IsVisualized || variable.IndexedChildCount == 0 || _engine.DebuggedProcess.Natvis.HasVisualizer(variable))
+                {
+                    return null;
+                }
+                return variable;
+            }
+        }
+
+        public int GetIndexedChildCount(out uint pCount)
+        {
+            VariableInformation variable = IndexedVariable;
+            pCount = variable?.IndexedChildCount ?? 0;
+            return variable != null ? Constants.S_OK : Constants.S_FALSE;
+        }
+
+        public int EnumChildrenRange(enum_DEBUGPROP_INFO_FLAGS dwFields, uint dwRadix, uint start, uint count, uint dwTimeout, out IEnumDebugPropertyInfo2 ppEnum)
+        {
+            ppEnum = null;
+
+            VariableInformation variable = IndexedVariable;
+            if (variable == null)
+            {
+                return Constants.S_FALSE;
+            }
+
+            variable.PropertyInfoFlags = dwFields;
+            VariableInformation[] children = variable.GetChildrenRange(start, count);
+            DEBUG_PROPERTY_INFO[] properties = new DEBUG_PROPERTY_INFO[children.Length];
+            for (int i = 0; i < children.Length; i++)
+            {
+                properties[i] = (new AD7Property(_engine, children[i])).ConstructDebugPropertyInfo(dwFields);
+            }
+            ppEnum = new AD7PropertyEnum(properties);
+            return Constants.S_OK;
+        }
+
+        #endregion
     }
 
     internal class AD7ErrorProperty : IDebugProperty3
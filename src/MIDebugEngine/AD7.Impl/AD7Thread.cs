@@ -6,13 +6,14 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Text;
 using Microsoft.VisualStudio.Debugger.Interop;
+using Microsoft.VisualStudio.Debugger.Interop.DAP;
 using System.Diagnostics;
 using MICore;
 
 namespace Microsoft.MIDebugEngine
 {
     // This class implements IDebugThread2 which represents a thread running in a program.
-    internal sealed class AD7Thread : IDebugThread2
+    internal sealed class AD7Thread : IDebugThread2, IDebugThreadDAP
     {
         private readonly AD7Engine _engine;
         private readonly DebuggedThread _debuggedThread;
@@ -109,8 +110,20 @@ namespace Microsoft.MIDebugEngine
         // Real engines will most likely want to cache this information to avoid recomputing it each time it is asked for,
         // and or construct it on demand instead of walking the entire stack.
         int IDebugThread2.EnumFrameInfo(enum_FRAMEINFO_FLAGS dwFieldSpec, uint nRadix, out IEnumDebugFrameInfo2 enumObject)
+        {
+            return EnumFrameInfo(dwFieldSpec, 0, 0, paged: false, out enumObject, out _);
+        }
+
+        // Retrieves only the requested range of stack frames, walking as little of the stack as possible.
+        int IDebugThreadDAP.EnumFrameInfoRange(enum_FRAMEINFO_FLAGS dwFieldSpec, uint nRadix, uint startFrame, uint levels, out IEnumDebugFrameInfo2 ppEnum, out uint totalFrames)
+        {
+            return EnumFrameInfo(dwFieldSpec, startFrame, levels, paged: true, out ppEnum, out totalFrames);
+        }
+
+        private int EnumFrameInfo(enum_FRAMEINFO_FLAGS dwFieldSpec, uint startFrame, uint levels, bool paged, out IEnumDebugFrameInfo2 enumObject, out uint totalFrames)
         {
             enumObject = null;
+            totalFrames = 0;
             try
             {
                 uint radix = _engine.CurrentRadix();
@@ -124,11 +137,59 @@ namespace Microsoft.MIDebugEngine
 
                 // get the thread's stack frames
                 System.Collections.Generic.List<ThreadContext> stackFrames = null;
-                _engine.DebuggedProcess.WorkerThread.RunOperation(async () => stackFrames = await _engine.DebuggedProcess.ThreadCache.StackFrames(_debuggedThread));
-                int numStackFrames = stackFrames != null ? stackFrames.Count : 0;
+                List<uint> frameIndices = null;
+                uint endFrame;
+                if (!paged)
+                {
+                    _engine.DebuggedProcess.WorkerThread.RunOperation(async () => stackFrames = await _engine.DebuggedProcess.ThreadCache.StackFrames(_debuggedThread));
+                    if (stackFrames != null)
+                    {
+                        stackFrames = new List<ThreadContext>(stackFrames);   // don't modify the cached stack
+                        frameIndices = FilterUnknownFrames(stackFrames);
+                        totalFrames = (uint)stackFrames.Count;
+                    }
+                    endFrame = totalFrames;
+                }
+                else
+                {
+                    endFrame = levels == 0 ? uint.MaxValue : startFrame + levels;
+                    bool complete = true;
+                    uint? depth = null;
+                    _engine.DebuggedProcess.WorkerThread.RunOperation(async () =>
+                    {
+                        // Collapsing unknown frames can leave fewer frames than were walked, so keep going until there are enough
+                        uint walk = endFrame;
+                        while (true)
+                        {
+                            (stackFrames, complete) = await _engine.DebuggedProcess.ThreadCache.StackFramesPrefix(_debuggedThread, walk);
+                            if (stackFrames == null)
+                            {
+                                break;
+                            }
+                            frameIndices = FilterUnknownFrames(stackFrames);
+                            if (complete || stackFrames.Count >= endFrame)
+                            {
+                                break;
+                            }
+                            walk += endFrame - (uint)stackFrames.Count;
+                        }
+
+                        if (stackFrames != null && !complete)
+                        {
+                            depth = await _engine.DebuggedProcess.ThreadCache.StackDepth(_debuggedThread);
+                        }
+                    });
+                    if (stackFrames != null)
+                    {
+                        // the depth counts frames that may still collapse into one unknown frame, DAP allows an overestimate
+                        totalFrames = complete ? (uint)stackFrames.Count : Math.Max(depth ?? 0, (uint)stackFrames.Count + 1);
+                    }
+                }
+
+                int numStackFrames = stackFrames != null ? Math.Max(0, Math.Min(stackFrames.Count, (int)Math.Min(endFrame, int.MaxValue)) - (int)startFrame) : 0;
                 FRAMEINFO[] frameInfoArray;
 
-                if (numStackFrames == 0)
+                if (numStackFrames <= 0)
                 {
                     // failed to walk any frames. Return an empty stack.
                     frameInfoArray = new FRAMEINFO[0];
@@ -138,19 +199,18 @@ namespace Microsoft.MIDebugEngine
                     // -stack-list-arguments takes a low/high *frame index* range. When a GDB Python
                     // frame filter is active, those numbers index the decorated stack, not the GDB frame
                     // level. Thus, synthetic frames are indexed even though they carry no level, and we
-                    // must request the whole [0, count-1] decorated range.
+                    // must request the whole decorated range covering the returned frames.
                     // Synthetic frames in the range have no arguments and are skipped in
                     // GetParameterInfoOnly, and results are matched back to frames by level below,
                     // so ordering within the range is moot.
-                    uint low = 0;
-                    uint high = (uint)(stackFrames.Count - 1);
-                    FilterUnknownFrames(stackFrames);
-                    numStackFrames = stackFrames.Count;
+                    int first = (int)startFrame;
+                    uint low = frameIndices[first];
+                    uint high = frameIndices[first + numStackFrames - 1];
                     frameInfoArray = new FRAMEINFO[numStackFrames];
                     List<ArgumentList> parameters = null;
 
                     if ((dwFieldSpec & enum_FRAMEINFO_FLAGS.FIF_FUNCNAME_ARGS) != 0 && !_engine.DebuggedProcess.MICommandFactory.SupportsFrameFormatting
-                        && stackFrames.Any(f => f.Level != null))
+                        && stackFrames.Skip(first).Take(numStackFrames).Any(f => f.Level != null))
                     {
                         _engine.DebuggedProcess.WorkerThread.RunOperation(async () => parameters = await _engine.DebuggedProcess.GetParameterInfoOnly(this, (dwFieldSpec & enum_FRAMEINFO_FLAGS.FIF_FUNCNAME_ARGS_VALUES) != 0,
                             (dwFieldSpec & enum_FRAMEINFO_FLAGS.FIF_FUNCNAME_ARGS_TYPES) != 0, low, high));
@@ -158,8 +218,9 @@ namespace Microsoft.MIDebugEngine
 
                     for (int i = 0; i < numStackFrames; i++)
                     {
-                        var p = parameters != null ? parameters.Find((ArgumentList t) => t.Item1 == stackFrames[i].Level) : null;
-                        AD7StackFrame frame = new AD7StackFrame(_engine, this, stackFrames[i]);
+                        ThreadContext context = stackFrames[first + i];
+                        var p = parameters != null ? parameters.Find((ArgumentList t) => t.Item1 == context.Level) : null;
+                        AD7StackFrame frame = new AD7StackFrame(_engine, this, context);
                         frame.SetFrameInfo(dwFieldSpec, out frameInfoArray[i], p != null ? p.Item2 : null);
                     }
                 }
@@ -177,10 +238,15 @@ namespace Microsoft.MIDebugEngine
             }
         }
 
-        private void FilterUnknownFrames(System.Collections.Generic.List<ThreadContext> stackFrames)
+        /// <summary>
+        /// Replace sequences of unknown frames with a single UnknownCode frame.
+        /// </summary>
+        /// <returns>The index in the unfiltered stack of each remaining frame</returns>
+        private List<uint> FilterUnknownFrames(System.Collections.Generic.List<ThreadContext> stackFrames)
         {
+            var frameIndices = new List<uint>(stackFrames.Count);
             bool lastWasQuestion = false;
-            for (int i = 0; i < stackFrames.Count;)
+            for (int i = 0, index = 0; i < stackFrames.Count; index++)
             {
                 // replace sequences of "??" with one UnknownCode frame
                 if (stackFrames[i].Function == null || stackFrames[i].Function.Equals("??", StringComparison.Ordinal))
@@ -197,8 +263,10 @@ namespace Microsoft.MIDebugEngine
                 {
                     lastWasQuestion = false;
                 }
+                frameIndices.Add((uint)index);
                 i++;
             }
+            return frameIndices;
         }
 
         // Get the name of the thread. For the sample engine, the name of the thread is always "Sample Engine Thread"
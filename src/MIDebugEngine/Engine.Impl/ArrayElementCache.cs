@@ -0,0 +1,67 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+
+namespace Microsoft.MIDebugEngine
+{
+    /// <summary>
+    /// The elements of an array fetched a range at a time, by index. Requests for overlapping ranges of the same array
+    /// can be handled at the same time, so this is locked.
+    /// </summary>
+    internal sealed class ArrayElementCache<T> where T : class
+    {
+        private readonly Dictionary<uint, T> _elements = new Dictionary<uint, T>();
+
+        /// <summary>
+        /// Limits the range [start, start + count) to an array of <paramref name="length"/> elements.
+        /// </summary>
+        /// <returns>The number of elements in the range</returns>
+        public static uint ClampCount(uint start, uint count, uint length)
+        {
+            return start >= length ? 0 : Math.Min(count, length - start);
+        }
+
+        public T Get(uint index)
+        {
+            lock (_elements)
+            {
+                T element;
+                _elements.TryGetValue(index, out element);
+                return element;
+            }
+        }
+
+        public void Add(uint start, T[] elements)
+        {
+            lock (_elements)
+            {
+                for (int i = 0; i < elements.Length; i++)
+                {
+                    _elements[start + (uint)i] = elements[i];
+                }
+            }
+        }
+
+        /// <summary>
+        /// Trims the elements already fetched from both ends of the range [start, end).
+        /// </summary>
+        /// <returns>False if all of the range has been fetched</returns>
+        public bool TrimFetched(ref uint start, ref uint end)
+        {
+            lock (_elements)
+            {
+                while (start < end && _elements.ContainsKey(start))
+                {
+                    start++;
+                }
+                while (end > start && _elements.ContainsKey(end - 1))
+                {
+                    end--;
+                }
+                return start != end;
+            }
+        }
+    }
+}
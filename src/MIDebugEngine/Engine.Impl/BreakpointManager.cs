@@ -100,25 +100,68 @@ namespace Microsoft.MIDebugEngine
             {
                 pending.SetError(new AD7ErrorBreakpoint(pending, warning), true);
             }
-            else
+            else if (!IsBoundToAllLocations(pending, bkpt))
             {
                 var bindList = await pending.PendingBreakpoint.BindAddresses(bkpt);
                 RebindAddresses(pending, bindList);
             }
         }
 
+        /// <summary>
+        /// Called after libraries load to pick up any pending breakpoints the debugger bound in them. Breakpoints
+        /// which are already bound or are being deleted are skipped, and the rest are queried with one pipelined batch.
+        /// </summary>
         public async Task BindAsync()
         {
-            var breakpointsToBind = CodeBreakpoints.Where((b) => b.PendingBreakpoint != null && b.PendingBreakpoint.IsPending);
+            var breakpointsToBind = CodeBreakpoints.Where((b) => b.PendingBreakpoint != null && b.PendingBreakpoint.IsPending && !b.Deleted && !b.PendingDelete).ToList();
+            if (breakpointsToBind.Count == 0)
+            {
+                return;
+            }
+
+            var bpLists = await PendingBreakpoint.SyncBreakpoints(_engine.DebuggedProcess, breakpointsToBind.Select(b => b.PendingBreakpoint).ToList());
+            for (int i = 0; i < breakpointsToBind.Count; i++)
+            {
+                RebindAddresses(breakpointsToBind[i], bpLists[i]);
+            }
+        }
+
+        /// <summary>
+        /// True if the breakpoint is already bound at every address GDB reports. GDB sends =breakpoint-modified
+        /// for every hit, including hits skipped by an ignore count, and those only change the hit count.
+        /// </summary>
+        private static bool IsBoundToAllLocations(AD7PendingBreakpoint pending, ResultValue bkpt)
+        {
+            AD7BoundBreakpoint[] bound = pending.EnumBoundBreakpoints();
+            if (bound.Length == 0)
+            {
+                return false;
+            }
 
-            if (breakpointsToBind != null)
+            if (bkpt.TryFind("locations", out var locations) && locations is ValueListValue list)
             {
-                foreach (var b in breakpointsToBind)
+                foreach (ResultValue location in list.Content)
                 {
-                    var bpList = await b.PendingBreakpoint.SyncBreakpoint(_engine.DebuggedProcess);
-                    RebindAddresses(b, bpList);
+                    if (!IsBoundAt(bound, location))
+                    {
+                        return false;
+                    }
                 }
+                return true;
+            }
+            return IsBoundAt(bound, bkpt);
+        }
+
+        private static bool IsBoundAt(AD7BoundBreakpoint[] bound, ResultValue location)
+        {
+            // <PENDING> and <MULTIPLE> aren't addresses
+            string addrString = location.TryFindString("addr");
+            if (addrString == null || !addrString.StartsWith("0x", StringComparison.Ordinal))
+            {
+                return false;
             }
+            ulong addr = location.FindAddr("addr");
+            return addr != 0 && Array.Exists(bound, (b) => b.Addr == addr);
         }
 
         private void RebindAddresses(AD7PendingBreakpoint pending, List<BoundBreakpoint> boundList)
@@ -3,6 +3,7 @@
 
 using System;
 using System.Collections.Generic;
+using System.Linq;
 using System.Text;
 using System.Diagnostics;
 using System.Threading.Tasks;
@@ -27,6 +28,7 @@ namespace Microsoft.MIDebugEngine
         private MIBreakpointState _breakState;    // how MI reported this breakpoint address
 
         public bool IsMultiple { get { return _breakState == MIBreakpointState.Multiple; } }
+        public bool IsLogpoint { get; private set; }    // inserted with LogpointInsert, whose condition is evaluated by the breakpoint
         public bool IsPending { get { return _breakState == MIBreakpointState.Pending; } }
         public DebuggedProcess DebuggedProcess { get { return AD7breakpoint.DebuggedProcess; } }
 
@@ -119,6 +121,31 @@ namespace Microsoft.MIDebugEngine
             return await EvalBindResult(await process.MICommandFactory.BreakInsert(compilerSrcName, process.UseUnixSymbolPaths, line, condition, enabled, checksums, ResultClass.None), pbreak);
         }
 
+        /// <summary>
+        /// Binds a logpoint as a breakpoint which the debugger prints the message of without stopping the process.
+        /// </summary>
+        internal static async Task<BindResult> Bind(string documentName, uint line, DebuggedProcess process, string condition, bool enabled, Logpoint logpoint, AD7PendingBreakpoint pbreak)
+        {
+            process.VerifyNotDebuggingCoreDump();
+
+            string compilerSrcName;
+            if (!process.MapCurrentSrcToCompileTimeSrc(documentName, out compilerSrcName))
+            {
+                compilerSrcName = Path.GetFileName(documentName);
+            }
+            if (logpoint.IsPlainText)
+            {
+                return await EvalBindResult(await process.MICommandFactory.DprintfInsert(compilerSrcName, process.UseUnixSymbolPaths, line, condition, enabled, logpoint.Format, ResultClass.None), pbreak);
+            }
+
+            BindResult result = await EvalBindResult(await process.MICommandFactory.LogpointInsert(compilerSrcName, process.UseUnixSymbolPaths, line, condition, enabled, logpoint.Parts), pbreak);
+            if (result.PendingBreakpoint != null)
+            {
+                result.PendingBreakpoint.IsLogpoint = true;
+            }
+            return result;
+        }
+
         private static async Task<BindResult> EvalBindResult(Results bindResult, AD7PendingBreakpoint pbreak)
         {
             string errormsg = "Unknown error";
@@ -162,7 +189,7 @@ namespace Microsoft.MIDebugEngine
             string bkptType = bkpt.FindString("type");
 
             // gdb reports breakpoint type "hw breakpoint" for `-break-insert -h` command
-            Debug.Assert(bkptType == "breakpoint" || bkptType == "hw breakpoint");
+            Debug.Assert(bkptType == "breakpoint" || bkptType == "hw breakpoint" || bkptType == "dprintf");
 
             string number = bkpt.FindString("number");
             string warning = bkpt.TryFindString("warning");
@@ -281,6 +308,21 @@ namespace Microsoft.MIDebugEngine
             return await BindAddresses(bkpt);
         }
 
+        /// <summary>
+        /// Queries the debugger for the current state of several breakpoints at once.
+        /// </summary>
+        /// <returns>The bound breakpoints of each pending breakpoint, in the same order</returns>
+        internal static async Task<List<BoundBreakpoint>[]> SyncBreakpoints(DebuggedProcess process, IReadOnlyList<PendingBreakpoint> breakpoints)
+        {
+            TupleValue[] bkpts = await process.MICommandFactory.BreakInfoBatch(breakpoints.Select(b => b.Number).ToList());
+            var boundLists = new List<BoundBreakpoint>[breakpoints.Count];
+            for (int i = 0; i < breakpoints.Count; i++)
+            {
+                boundLists[i] = await breakpoints[i].BindAddresses(bkpts[i]);
+            }
+            return boundLists;
+        }
+
         internal async Task<List<BoundBreakpoint>> BindAddresses(ResultValue bkpt)
         {
             List<BoundBreakpoint> resultList = new List<BoundBreakpoint>();
@@ -350,7 +392,14 @@ namespace Microsoft.MIDebugEngine
         {
             if (process.ProcessState != MICore.ProcessState.Exited)
             {
-                await process.MICommandFactory.BreakCondition(Number, expr);
+                if (IsLogpoint)
+                {
+                    await process.MICommandFactory.LogpointCondition(Number, expr);
+                }
+                else
+                {
+                    await process.MICommandFactory.BreakCondition(Number, expr);
+                }
             }
         }
 
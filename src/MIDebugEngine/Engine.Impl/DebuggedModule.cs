@@ -91,6 +91,55 @@ namespace Microsoft.MIDebugEngine
             return Sections.Find((s) => s.BaseAddress <= address && address < s.BaseAddress + s.Size) != null;
         }
 
+        /// <summary>
+        /// Reads the address range of a library from the 'ranges' field reported by gdb in =library-loaded and
+        /// -file-list-shared-libraries, e.g. ranges=[{from="0x7ffff7fc5090",to="0x7ffff7fee335"}]
+        /// </summary>
+        /// <returns>False if the library has no ranges</returns>
+        internal static bool TryGetLibraryRange(ResultValue library, out ulong baseAddr, out ulong size)
+        {
+            baseAddr = ulong.MaxValue;
+            ulong endAddr = 0;
+            if (library.TryFind("ranges", out ResultValue ranges) && ranges is ValueListValue rangeList)
+            {
+                foreach (ResultValue range in rangeList.Content)
+                {
+                    ulong? from = range.TryFindAddr("from");
+                    ulong? to = range.TryFindAddr("to");
+                    if (from.HasValue && to.HasValue && from.Value <= to.Value)
+                    {
+                        baseAddr = Math.Min(baseAddr, from.Value);
+                        endAddr = Math.Max(endAddr, to.Value);
+                    }
+                }
+            }
+
+            if (baseAddr > endAddr)
+            {
+                baseAddr = 0;
+                size = 0;
+                return false;
+            }
+            size = endAddr - baseAddr;
+            return true;
+        }
+
+        /// <summary>
+        /// Enumerates the [start, end) address ranges covered by the module's sections. Empty sections are skipped.
+        /// </summary>
+        internal IEnumerable<KeyValuePair<ulong, ulong>> AddressRanges()
+        {
+            foreach (Section s in Sections)
+            {
+                if (s.Size == 0)
+                {
+                    continue;
+                }
+                ulong end = s.Size > ulong.MaxValue - s.BaseAddress ? ulong.MaxValue : s.BaseAddress + s.Size;
+                yield return new KeyValuePair<ulong, ulong>(s.BaseAddress, end);
+            }
+        }
+
         private Section TextSection
         {
             get
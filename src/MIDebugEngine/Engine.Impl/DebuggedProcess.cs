@@ -26,6 +26,7 @@ namespace Microsoft.MIDebugEngine
         public List<string> VariablesToDelete { get; private set; }
         public List<string> DataBreakpointVariables { get; private set; }
         public List<IVariableInformation> ActiveVariables { get; private set; }
+        public VariableObjectPool VariableObjects { get; private set; }
         public VariableInformation ReturnValue { get; private set; }
         public SourceLineCache SourceLineCache { get; private set; }
         public ThreadCache ThreadCache { get; private set; }
@@ -34,14 +35,32 @@ namespace Microsoft.MIDebugEngine
         public CygwinFilePathMapper CygwinFilePathMapper { get; private set; }
 
         private List<DebuggedModule> _moduleList;
+        private volatile ModuleAddressIndex _moduleIndex = ModuleAddressIndex.Empty;    // replaced under the _moduleList lock, read without it
         private ISampleEngineCallback _callback;
         private bool _bLastModuleLoadFailed;
         private StringBuilder _pendingMessages;
+        private readonly ProgramOutputBuffer _outputBuffer;
         private WorkerThread _worker;
         private BreakpointManager _breakpointManager;
         private ResultEventArgs _initialBreakArgs;
         private List<string> _libraryLoaded;   // unprocessed library loaded messages
+        private List<string> _librariesToSync = new List<string>();  // libraries loaded since breakpoints and modules were last synced
+        private List<string> _modulesToRefresh = new List<string>(); // modules added from =library-loaded whose symbol state isn't known yet
+        private bool _moduleResyncNeeded;      // a library load couldn't be tracked from its notification
+        private bool _fileListSharedLibrariesSupported = true;
+        private HashSet<DebuggedModule> _onDemandSymbolLoads = new HashSet<DebuggedModule>();   // modules whose symbols were loaded on demand, or tried to be
         private uint _loadOrder;
+        private Task _variableObjectsUpdate;   // the "-var-update *" of the pooled variable objects
+        private readonly object _logpointTypeLock = new object();
+        private Task<bool> _logpointType;   // definition of the breakpoint type logpoints are inserted as
+        private readonly object _targetEndianLock = new object();
+        private Task<bool> _isTargetLittleEndian;
+        private SourceFileMapper _sourceFileMapper;
+        private const int MaxMappedFileNames = 4096;
+        private readonly Dictionary<string, string> _mappedFileNames = new Dictionary<string, string>(StringComparer.Ordinal);   // file names reported by the debugger, mapped to editor file names
+        private int _variableObjectsUpdateGeneration;
+        private readonly Dictionary<Tuple<int, uint>, Task<string>> _frameIdentities = new Dictionary<Tuple<int, uint>, Task<string>>();  // (thread, level) -> identity of the frame during this break
+        private string _stopSourceFile;        // source file of the last stop, for PrefetchSourceLines
         private HostWaitDialog _waitDialog;
         public readonly Natvis.Natvis Natvis;
         private ReadOnlyCollection<RegisterDescription> _registers;
@@ -84,15 +103,28 @@ namespace Microsoft.MIDebugEngine
             VariablesToDelete = new List<string>();
             DataBreakpointVariables = new List<string>();
             this.ActiveVariables = new List<IVariableInformation>();
+            VariableObjects = new VariableObjectPool();
             _fileTimestampWarnings = new HashSet<Tuple<string, string>>();
 
+            _outputBuffer = new ProgramOutputBuffer(_callback.OnOutputString, launchOptions.OutputMaxLinesPerSecond, launchOptions.OutputLogFile, Logger);
             OutputStringEvent += delegate (object o, string message)
             {
                 // We can get messages before we have started the process
                 // but we can't send them on until it is
                 if (_connected)
                 {
-                    _callback.OnOutputString(message);
+                    _outputBuffer.Write(message, isProgramOutput: false);
+                }
+                else
+                {
+                    _pendingMessages.Append(message);
+                }
+            };
+            ProgramOutputEvent += delegate (object o, string message)
+            {
+                if (_connected)
+                {
+                    _outputBuffer.Write(message, isProgramOutput: true);
                 }
                 else
                 {
@@ -107,6 +139,15 @@ namespace Microsoft.MIDebugEngine
                 if (!string.IsNullOrEmpty(file) && MICommandFactory.SupportsStopOnDynamicLibLoad())
                 {
                     _libraryLoaded.Add(file);
+                    DebuggedModule module = AddLibrary(results.Results);
+                    if (module != null)
+                    {
+                        _modulesToRefresh.Add(module.Id);
+                    }
+                    else
+                    {
+                        _moduleResyncNeeded = true;
+                    }
                     if (_waitDialog != null)
                     {
                         _waitDialog.ShowWaitDialog(file);
@@ -146,6 +187,20 @@ namespace Microsoft.MIDebugEngine
                 }
             };
 
+            LibraryUnloadEvent += delegate (object o, EventArgs args)
+            {
+                ResultEventArgs results = args as MICore.Debugger.ResultEventArgs;
+                string hostName = results.Results.TryFindString("host-name");
+                if (string.IsNullOrEmpty(hostName))
+                {
+                    hostName = results.Results.TryFindString("id");
+                }
+                if (!string.IsNullOrEmpty(hostName))
+                {
+                    RemoveModule(hostName);
+                }
+            };
+
             if (_launchOptions is LocalLaunchOptions)
             {
                 LocalLaunchOptions localLaunchOptions = (LocalLaunchOptions)_launchOptions;
@@ -255,6 +310,8 @@ namespace Microsoft.MIDebugEngine
                     }
                 }
 
+                _outputBuffer.Flush();
+
                 // quit MI Debugger
                 if (!this.IsClosed)
                 {
@@ -279,6 +336,7 @@ namespace Microsoft.MIDebugEngine
 
                 // this is the last AD7 Event we can ever send
                 // Also the transport is closed when this returns
+                _outputBuffer.Close();
                 _callback.OnProcessExit(processExitCode);
 
                 Dispose();
@@ -299,6 +357,7 @@ namespace Microsoft.MIDebugEngine
                             return;
                         }
 
+                        _outputBuffer.Close();
                         _callback.OnError(string.Concat(eventArgs.Message, " ", ResourceStrings.DebuggingWillAbort));
                         _callback.OnProcessExit(uint.MaxValue);
 
@@ -324,8 +383,9 @@ namespace Microsoft.MIDebugEngine
                     await CmdAsync("-gdb-set stop-on-solib-events 0", ResultClass.None);
                 }
 
-                await this.EnsureModulesLoaded();
-
+                // If the process is about to be continued, leave syncing breakpoints and modules until the next stop
+                bool willContinue = this.MICommandFactory.SupportsStopOnDynamicLibLoad() && !this.IsCoreDump;
+                await this.EnsureModulesLoaded(deferSync: willContinue);
 
                 if (_waitDialog != null)
                 {
@@ -361,6 +421,8 @@ namespace Microsoft.MIDebugEngine
                 try
                 {
                     await HandleBreakModeEvent(results, results.AsyncRequest);
+                    PrefetchSourceLines();
+                    DeleteVariableObjects();
                 }
                 catch (Exception e) when (ExceptionHelper.BeforeCatch(e, Logger, reportOnlyCorrupting: true))
                 {
@@ -472,11 +534,18 @@ namespace Microsoft.MIDebugEngine
             }
         }
 
-        private async Task EnsureModulesLoaded()
+        /// <summary>
+        /// Processes libraries loaded since the last call.
+        /// </summary>
+        /// <param name="deferSync">True if the process is about to be continued. Loading symbols is done immediately, but
+        /// binding pending breakpoints and refreshing the module list is left to the next call without deferSync. This
+        /// coalesces the work for all libraries loaded at solib event stops into a single pass.</param>
+        private async Task EnsureModulesLoaded(bool deferSync = false)
         {
-            if (_libraryLoaded.Count != 0)
+            if (_libraryLoaded.Count != 0 || (_librariesToSync.Count != 0 && !deferSync))
             {
-                string moduleNames = string.Join(", ", _libraryLoaded);
+                _librariesToSync.AddRange(_libraryLoaded);
+                string moduleNames = string.Join(", ", _librariesToSync);
 
                 try
                 {
@@ -495,14 +564,14 @@ namespace Microsoft.MIDebugEngine
                             {
                                 if (!_launchOptions.SymbolInfoLoadAll)
                                 {
-                                    await LoadSymbols(filename);
+                                    await LoadSymbols(filename, EngineTelemetry.SymbolLoadTrigger.LibraryLoad);
                                 }
                             }
                             else
                             {
                                 if (_launchOptions.SymbolInfoLoadAll)
                                 {
-                                    await LoadSymbols(filename);
+                                    await LoadSymbols(filename, EngineTelemetry.SymbolLoadTrigger.LibraryLoad);
                                 }
                             }
                         }
@@ -511,8 +580,15 @@ namespace Microsoft.MIDebugEngine
                     _libraryLoaded.Clear();
                     SourceLineCache.OnLibraryLoad();
 
-                    await _breakpointManager.BindAsync();
-                    await CheckModules();
+                    if (!deferSync)
+                    {
+                        _librariesToSync.Clear();
+                        List<string> modulesToRefresh = _modulesToRefresh;
+                        _modulesToRefresh = new List<string>();
+
+                        await _breakpointManager.BindAsync();
+                        await RefreshModules(modulesToRefresh);
+                    }
 
                     _bLastModuleLoadFailed = false;
                 }
@@ -1081,6 +1157,9 @@ namespace Microsoft.MIDebugEngine
 
         private async Task HandleBreakModeEvent(ResultEventArgs results, BreakRequest breakRequest)
         {
+            // Output printed before the stop should show up before it
+            _outputBuffer.Flush();
+
             string reason = results.Results.TryFindString("reason");
             int tid;
             if (!results.Results.Contains("thread-id"))
@@ -1099,7 +1178,12 @@ namespace Microsoft.MIDebugEngine
             }
 
             // Any existing variable objects at this point are from the last time we were in break mode, and are
-            //  therefore invalid.  Dispose them so they're marked for cleanup.
+            //  therefore invalid.  Dispose them so they're marked for cleanup, or kept for reuse by the pool.
+            VariableObjects.OnBreak();
+            lock (_frameIdentities)
+            {
+                _frameIdentities.Clear();
+            }
             lock (this.ActiveVariables)
             {
                 foreach (IVariableInformation varInfo in this.ActiveVariables)
@@ -1131,7 +1215,7 @@ namespace Microsoft.MIDebugEngine
             }
 
             await this.EnsureModulesLoaded();
-            await ThreadCache.StackFrames(thread);  // prepopulate the break thread in the thread cache
+            await ThreadCache.StackFramesPrefix(thread, ThreadCache.StackPageSize);  // prepopulate the top of the break thread's stack in the thread cache
             ThreadContext cxt = await ThreadCache.GetThreadContext(thread);
 
             if (cxt == null)
@@ -1144,6 +1228,7 @@ namespace Microsoft.MIDebugEngine
                 throw new Exception(String.Format(CultureInfo.CurrentCulture, ResourceStrings.MissingThreadBreakEvent, tid));
             }
 
+            _stopSourceFile = cxt.TextPosition?.FileName;
             ThreadCache.SendThreadEvents(this, null);   // make sure that new threads have been pushed to the UI
 
             // If didn't hit a breakpoints then delete all pending deletions on break mode
@@ -1153,27 +1238,6 @@ namespace Microsoft.MIDebugEngine
                 await _breakpointManager.DeleteBreakpointsPendingDeletion();
             }
 
-            // Delete GDB variable objects that have been marked for cleanup
-            List<string> variablesToDelete = null;
-            lock (VariablesToDelete)
-            {
-                variablesToDelete = new List<string>(this.VariablesToDelete);
-                VariablesToDelete.Clear();
-            }
-
-            foreach (var variable in variablesToDelete)
-            {
-                try
-                {
-                    await MICommandFactory.VarDelete(variable);
-                }
-                catch (MIException)
-                {
-                    //not much to do really, we're leaking MI debugger variables.
-                    Debug.Fail("Failed to delete variable: " + variable + ". This is leaking memory in the MI Debugger.");
-                }
-            }
-
             if (String.IsNullOrWhiteSpace(reason) && !this.EntrypointHit)
             {
                 breakRequest = BreakRequest.None;   // don't let stopping interfere with launch processing
@@ -1492,7 +1556,7 @@ namespace Microsoft.MIDebugEngine
             await this.EnsureModulesLoaded();
 
             string targetModulePath = this._launchOptions.ExePath;
-            DebuggedModule targetModule = _moduleList.FirstOrDefault(m => m.AddressInModule(addr));
+            DebuggedModule targetModule = FindModule(addr);
             if (targetModule != null)
             {
                 targetModulePath = targetModule.Name;
@@ -1599,8 +1663,8 @@ namespace Microsoft.MIDebugEngine
                 {
                     Task evalTask = Task.Run(async () =>
                     {
-                        await LoadSymbols(GetFileName(module.Name));
-                        await CheckModules();
+                        await LoadSymbols(GetFileName(module.Name), EngineTelemetry.SymbolLoadTrigger.User);
+                        await RefreshModules(new string[] { module.Id });
                     });
                 }
             }
@@ -1610,9 +1674,123 @@ namespace Microsoft.MIDebugEngine
             }
         }
 
-        private async Task<string> LoadSymbols(string filename)
+        private async Task<string> LoadSymbols(string filename, EngineTelemetry.SymbolLoadTrigger trigger)
         {
-            return await ConsoleCmdAsync("sharedlibrary " + filename, allowWhileRunning: false);
+            Stopwatch timer = Stopwatch.StartNew();
+            string result = await ConsoleCmdAsync("sharedlibrary " + filename, allowWhileRunning: false);
+            timer.Stop();
+            SourceLineCache.OnLibraryLoad();    // the new symbols may have lines for files which had none
+
+            Logger.WriteLine(LogLevel.Verbose, "Loaded symbols for {0} in {1}ms ({2})", filename, timer.ElapsedMilliseconds, trigger);
+            _engineTelemetry.SendSymbolLoad(trigger, timer.ElapsedMilliseconds, _launchOptions.SymbolInfoLoadOnDemand);
+            return result;
+        }
+
+        /// <summary>
+        /// When symbols are loaded on demand, loads the symbols of the modules the given frames are in. Each module is
+        /// only tried once, so modules gdb can't find symbols for don't slow down every stack walk.
+        /// </summary>
+        /// <param name="frames">Frames from -stack-list-frames</param>
+        /// <returns>True if symbols were loaded, in which case the frames are out of date</returns>
+        internal async Task<bool> LoadSymbolsForFrames(IEnumerable<TupleValue> frames)
+        {
+            if (!_launchOptions.SymbolInfoLoadOnDemand || MICommandFactory.Mode != MIMode.Gdb)
+            {
+                return false;
+            }
+
+            List<DebuggedModule> modules = new List<DebuggedModule>();
+            lock (_onDemandSymbolLoads)
+            {
+                foreach (TupleValue frame in frames)
+                {
+                    ulong? pc = frame.TryFindAddr("addr");
+                    DebuggedModule module = pc.HasValue ? FindModule(pc.Value) : null;
+                    if (module != null && !module.SymbolsLoaded && _onDemandSymbolLoads.Add(module))
+                    {
+                        modules.Add(module);
+                    }
+                }
+            }
+            if (modules.Count == 0)
+            {
+                return false;
+            }
+
+            foreach (DebuggedModule module in modules)
+            {
+                await LoadSymbols(GetFileName(module.Name), EngineTelemetry.SymbolLoadTrigger.StackFrame);
+            }
+            await RefreshModules(modules.Select(m => m.Id).ToList());
+            return true;
+        }
+
+        /// <summary>
+        /// Brings the module list up to date after libraries load. Modules are added from =library-loaded as it arrives,
+        /// but gdb reads their symbols afterwards, so their symbol state is looked up here with one pipelined
+        /// -file-list-shared-libraries per module. If a load couldn't be tracked from its notification the whole list is
+        /// resynced instead, and if -file-list-shared-libraries isn't supported "info sharedlibrary" is parsed.
+        /// </summary>
+        /// <param name="modules">Ids of the modules to refresh</param>
+        private async Task RefreshModules(IReadOnlyList<string> modules)
+        {
+            bool resync = _moduleResyncNeeded;
+            _moduleResyncNeeded = false;
+            if (!resync && modules.Count == 0)
+            {
+                return;
+            }
+
+            if (_fileListSharedLibrariesSupported)
+            {
+                ValueListValue[] libraryLists;
+                if (resync)
+                {
+                    ValueListValue libraries = await MICommandFactory.FileListSharedLibraries();
+                    libraryLists = libraries != null ? new ValueListValue[] { libraries } : null;
+                }
+                else
+                {
+                    libraryLists = await MICommandFactory.FileListSharedLibraries(modules);
+                }
+
+                if (libraryLists != null)
+                {
+                    foreach (ValueListValue libraries in libraryLists)
+                    {
+                        foreach (ResultValue library in libraries.Content)
+                        {
+                            AddLibrary(library);
+                        }
+                    }
+                    return;
+                }
+
+                _fileListSharedLibrariesSupported = false;
+            }
+
+            await CheckModules();
+        }
+
+        /// <summary>
+        /// Adds or updates a module from a =library-loaded notification or a -file-list-shared-libraries entry.
+        /// </summary>
+        /// <returns>The module, or null if the library has no address range</returns>
+        private DebuggedModule AddLibrary(ResultValue library)
+        {
+            string hostName = library.TryFindString("host-name");
+            if (string.IsNullOrEmpty(hostName))
+            {
+                hostName = library.TryFindString("id");
+            }
+            if (string.IsNullOrEmpty(hostName) || !DebuggedModule.TryGetLibraryRange(library, out ulong baseAddr, out ulong size))
+            {
+                return null;
+            }
+
+            // symbols-loaded is 0 in =library-loaded since gdb reads the symbols after reporting the load
+            bool symbolsLoaded = library.TryFindString("symbols-loaded") == "1";
+            return AddModule(hostName, hostName, baseAddr, size, symbolsLoaded, hostName);
         }
 
         private async Task CheckModules()
@@ -1690,6 +1868,7 @@ namespace Microsoft.MIDebugEngine
                         module.IgnoreSource = true;
                     }
                     _moduleList.Add(module);
+                    _moduleIndex = _moduleIndex.Add(module);
                 }
 
                 _callback.OnModuleLoad(module);
@@ -1702,6 +1881,29 @@ namespace Microsoft.MIDebugEngine
             return module;
         }
 
+        private void RemoveModule(string id)
+        {
+            DebuggedModule module;
+            lock (_moduleList)
+            {
+                module = _moduleList.Find((m) => m.Id == id);
+                if (module == null)
+                {
+                    return;
+                }
+                _moduleList.Remove(module);
+                _moduleIndex = _moduleIndex.Remove(module);
+            }
+
+            _modulesToRefresh.Remove(id);
+            lock (_onDemandSymbolLoads)
+            {
+                _onDemandSymbolLoads.Remove(module);
+            }
+            SourceLineCache.OnModuleUnload(module);
+            _callback.OnModuleUnload(module);
+        }
+
         // this is called on any thread, so we need to dispatch the command via
         // the Worker thread, to end up in DispatchCommand
         protected override void ScheduleStdOutProcessing(string line)
@@ -1792,10 +1994,7 @@ namespace Microsoft.MIDebugEngine
 
         public DebuggedModule ResolveAddress(ulong addr)
         {
-            lock (_moduleList)
-            {
-                return _moduleList.Find((m) => m.AddressInModule(addr));
-            }
+            return _moduleIndex.Find(addr);
         }
 
         public void Close()
@@ -1948,10 +2147,7 @@ namespace Microsoft.MIDebugEngine
 
         public DebuggedModule FindModule(ulong addr)
         {
-            lock (_moduleList)
-            {
-                return _moduleList.Find((m) => m.AddressInModule(addr));
-            }
+            return _moduleIndex.Find(addr);
         }
 
         public bool GetSourceInformation(uint addr, ref string m_documentName, ref string m_functionName, ref uint m_lineNum, ref uint m_numParameters, ref uint m_numLocals)
@@ -2117,14 +2313,73 @@ namespace Microsoft.MIDebugEngine
             return parameters;
         }
 
+        // Large reads are split so that gdb replies stay a reasonable size and can be decoded while gdb produces the next one
+        private const uint MemoryReadChunkSize = 1024 * 1024;
+
         internal async Task<uint> ReadProcessMemory(ulong address, uint count, byte[] bytes)
         {
-            string cmd = "-data-read-memory-bytes " + EngineUtils.AsAddr(address, Is64BitArch) + " " + count.ToString(CultureInfo.InvariantCulture);
-            Results results = await CmdAsync(cmd, ResultClass.None);
-            if (results.ResultClass == ResultClass.error)
+            uint bytesRead;
+            if (TryReadProcessMemoryDirect(address, count, bytes, out bytesRead))
+            {
+                return bytesRead;
+            }
+
+            var commands = new List<string>();
+            for (uint offset = 0; offset < count; offset += MemoryReadChunkSize)
+            {
+                uint chunkSize = Math.Min(MemoryReadChunkSize, count - offset);
+                commands.Add("-data-read-memory-bytes " + EngineUtils.AsAddr(address + offset, Is64BitArch) + " " + chunkSize.ToString(CultureInfo.InvariantCulture));
+            }
+
+            Results[] chunks = commands.Count == 1
+                ? new Results[] { await CmdAsync(commands[0], ResultClass.None) }
+                : await CmdBatchAsync(commands, ResultClass.None);
+
+            return DecodeMemoryChunks(chunks, address, count, MemoryReadChunkSize, bytes);
+        }
+
+        /// <summary>
+        /// Decodes the replies to consecutive -data-read-memory-bytes requests of <paramref name="chunkSize"/> bytes each.
+        /// Reading stops at the first chunk that fails, comes back short, or doesn't start at the requested address.
+        /// </summary>
+        /// <returns>The number of bytes read, or uint.MaxValue if the first chunk failed</returns>
+        internal static uint DecodeMemoryChunks(Results[] chunks, ulong address, uint count, uint chunkSize, byte[] bytes)
+        {
+            uint bytesRead = 0;
+            foreach (Results results in chunks)
             {
-                return uint.MaxValue;
+                if (results.ResultClass == ResultClass.error)
+                {
+                    return bytesRead == 0 ? uint.MaxValue : bytesRead;
+                }
+
+                uint size = Math.Min(chunkSize, count - bytesRead);
+                if (bytesRead != 0 && !MemoryContentsStartAt(results, address + bytesRead))
+                {
+                    // the chunk starts in unreadable memory, keep what the earlier chunks read
+                    break;
+                }
+
+                uint chunkRead = DecodeMemoryContents(results, address + bytesRead, size, bytes, bytesRead);
+                bytesRead += chunkRead;
+                if (chunkRead < size)
+                {
+                    // the rest of the range is not readable
+                    break;
+                }
             }
+            return bytesRead;
+        }
+
+        private static bool MemoryContentsStartAt(Results results, ulong address)
+        {
+            ValueListValue mem = results.Find<ValueListValue>("memory");
+            TupleValue res = mem.IsEmpty() ? null : mem.Content[0] as TupleValue;
+            return res != null && res.FindAddr("begin") + res.FindAddr("offset") == address;
+        }
+
+        private static uint DecodeMemoryContents(Results results, ulong address, uint count, byte[] bytes, uint bytesOffset)
+        {
             ValueListValue mem = results.Find<ValueListValue>("memory");
             if (mem.IsEmpty())
             {
@@ -2136,7 +2391,6 @@ namespace Microsoft.MIDebugEngine
                 return 0;
             }
             ulong start = res.FindAddr("begin");
-            ulong end = res.FindAddr("end");
             ulong offset = res.FindAddr("offset");   // for some reason this is formatted as hex
             string content = res.FindString("contents");
             uint toRead = (uint)content.Length / 2;
@@ -2150,12 +2404,7 @@ namespace Microsoft.MIDebugEngine
                 throw new MIException(Constants.E_FAIL);
             }
 
-            for (int pos = 0; pos < toRead; ++pos)
-            {
-                // Decode one byte
-                string strByte = content.Substring(pos * 2, 2);
-                bytes[pos] = Convert.ToByte(strByte, 16);
-            }
+            EngineUtils.DecodeHexBytes(content, bytes, (int)bytesOffset, (int)toRead);
             return toRead;
         }
 
@@ -2290,7 +2539,6 @@ namespace Microsoft.MIDebugEngine
         /// </summary>
         public async Task<uint> LineForStartAddress(string file, ulong startAddress)
         {
-            List<ulong> addresses = new List<ulong>();
             SourceLineMap srcLines = await SourceLineCache.GetLinesForFile(file);
             if (srcLines == null || srcLines.Count == 0)
             {
@@ -2301,14 +2549,182 @@ namespace Microsoft.MIDebugEngine
                 return 0;
             }
 
-            SourceLine srcLine;
-            if (srcLines.TryGetValue(startAddress, out srcLine))
+            uint srcLine;
+            if (srcLines.TryGetLine(startAddress, out srcLine))
             {
-                return srcLine.Line;
+                return srcLine;
             }
             return 0;
         }
 
+        /// <summary>
+        /// Defines the breakpoint type logpoints with interpolations are inserted as, the first time one needs it.
+        /// </summary>
+        /// <returns>false if the debugger couldn't define it, e.g. because it was built without python</returns>
+        internal Task<bool> EnsureLogpointType()
+        {
+            lock (_logpointTypeLock)
+            {
+                if (_logpointType == null)
+                {
+                    _logpointType = MICommandFactory.DefineLogpointType();
+                }
+                return _logpointType;
+            }
+        }
+
+        /// <summary>
+        /// True if the target is little-endian, which the debugger is only asked once. Arrays of primitives are only
+        /// decoded from memory for those targets.
+        /// </summary>
+        internal Task<bool> IsTargetLittleEndian()
+        {
+            lock (_targetEndianLock)
+            {
+                if (_isTargetLittleEndian == null)
+                {
+                    _isTargetLittleEndian = MICommandFactory.IsTargetLittleEndian();
+                }
+                return _isTargetLittleEndian;
+            }
+        }
+
+        /// <summary>
+        /// Gets a string which identifies the call at a frame level during this break, so variable objects bound to a
+        /// frame are only reused for that same call, at whatever level it is now. This is the function and its stack
+        /// pointer, which is what gdb uses for frame ids. A function whose stack pointer moves within its body only
+        /// loses reuse.
+        /// </summary>
+        /// <returns>The identity, or null if the stack pointer couldn't be read</returns>
+        internal Task<string> GetFrameIdentity(int threadId, uint level, string function)
+        {
+            var key = new Tuple<int, uint>(threadId, level);
+            lock (_frameIdentities)
+            {
+                Task<string> identity;
+                if (!_frameIdentities.TryGetValue(key, out identity))
+                {
+                    identity = ReadFrameIdentity(threadId, level, function);
+                    _frameIdentities.Add(key, identity);
+                }
+                return identity;
+            }
+        }
+
+        private async Task<string> ReadFrameIdentity(int threadId, uint level, string function)
+        {
+            try
+            {
+                string sp = await MICommandFactory.DataEvaluateExpression("$sp", threadId, level);
+                return string.IsNullOrEmpty(sp) ? null : function + "@" + sp;
+            }
+            catch (MIException)
+            {
+                return null;
+            }
+        }
+
+        /// <summary>
+        /// Takes a pooled variable object for reuse. The first time this is called in a break, all the pooled objects
+        /// are refreshed by a single "-var-update *" instead of one -var-update for each object reused.
+        /// </summary>
+        internal async Task<VariableObjectPool.Entry> TakeVariableObject(VariableObjectPool.Key key)
+        {
+            Task update = null;
+            lock (VariableObjects)
+            {
+                if (VariableObjects.NeedsUpdate)
+                {
+                    if (_variableObjectsUpdate == null || _variableObjectsUpdateGeneration != VariableObjects.Generation)
+                    {
+                        _variableObjectsUpdateGeneration = VariableObjects.Generation;
+                        _variableObjectsUpdate = UpdateVariableObjects();
+                    }
+                    update = _variableObjectsUpdate;
+                }
+            }
+            if (update != null)
+            {
+                await update;
+            }
+            return VariableObjects.Take(key);
+        }
+
+        private async Task UpdateVariableObjects()
+        {
+            TupleValue[] changelist = null;
+            try
+            {
+                Results results = await MICommandFactory.VarUpdate("*", ResultClass.None);
+                if (results.ResultClass == ResultClass.done)
+                {
+                    changelist = results.Find<ValueListValue>("changelist").AsArray<TupleValue>();
+                }
+            }
+            catch (MIException)
+            {
+                // the objects are updated one at a time when they are reused
+            }
+            List<string> removed = VariableObjects.Update(changelist);
+            lock (VariablesToDelete)
+            {
+                VariablesToDelete.AddRange(removed);
+            }
+        }
+
+        /// <summary>
+        /// Deletes the variable objects marked for cleanup and the ones the pool expired. This runs after the stop has
+        /// been handled and sends all the deletes back-to-back, so large watch windows don't delay stepping.
+        /// </summary>
+        private void DeleteVariableObjects()
+        {
+            List<string> variablesToDelete;
+            lock (VariablesToDelete)
+            {
+                VariablesToDelete.AddRange(VariableObjects.Expire());
+                if (VariablesToDelete.Count == 0 || ProcessState != ProcessState.Stopped)
+                {
+                    return;     // if the process was continued they are deleted at the next stop
+                }
+                variablesToDelete = new List<string>(this.VariablesToDelete);
+                VariablesToDelete.Clear();
+            }
+
+            Task.Run(async () =>
+            {
+                try
+                {
+                    await MICommandFactory.VarDeleteBatch(variablesToDelete);
+                }
+                catch (MIException)
+                {
+                    //not much to do really, we're leaking MI debugger variables.
+                    Logger.WriteLine(LogLevel.Verbose, "Failed to delete {0} variable objects. This is leaking memory in the MI Debugger.", variablesToDelete.Count);
+                }
+            });
+        }
+
+        /// <summary>
+        /// Starts loading the line table of the file the process stopped in. This runs after the stop has been handled,
+        /// so it doesn't delay it, and setting breakpoints or disassembling in that file then finds the lines cached.
+        /// </summary>
+        private void PrefetchSourceLines()
+        {
+            string file = _stopSourceFile;
+            _stopSourceFile = null;
+            if (file == null || ProcessState != ProcessState.Stopped)
+            {
+                return;
+            }
+
+            string compFile;
+            if (MapCurrentSrcToCompileTimeSrc(file, out compFile))
+            {
+                file = compFile;
+            }
+            SourceLineCache.Prefetch(file);
+        }
+
         public async Task<List<ulong>> StartAddressesForLine(string file, uint line)
         {
             List<ulong> addresses = new List<ulong>();
@@ -2329,22 +2745,7 @@ namespace Microsoft.MIDebugEngine
             }
             if (srcLines != null && srcLines.Count > 0)
             {
-                bool gotoNextFunc = false;
-                foreach (KeyValuePair<ulong, SourceLine> l in srcLines)
-                {
-                    if (gotoNextFunc)
-                    {
-                        if (l.Value.Line == 0)
-                        {
-                            gotoNextFunc = false;
-                        }
-                    }
-                    else if (line == l.Value.Line)
-                    {
-                        addresses.Add(l.Value.AddrStart);
-                        gotoNextFunc = true;
-                    }
-                }
+                addresses = srcLines.StartAddressesForLine(line);
             }
             if (addresses.Count == 0)
             {
@@ -2365,40 +2766,26 @@ namespace Microsoft.MIDebugEngine
 
         public bool IsChildProcessDebugging => _childProcessHandler != null;
 
-        public bool MapCurrentSrcToCompileTimeSrc(string currentSrc, out string compilerSrc)
+        private SourceFileMapper SourceFileMapper
         {
-            if (_launchOptions.SourceMap != null)
+            get
             {
-                StringComparison comp = PlatformUtilities.IsWindows() ? StringComparison.OrdinalIgnoreCase : StringComparison.Ordinal;
-                foreach (var e in _launchOptions.SourceMap)
+                // Launch options can't change once created, so the index is built on first use and kept
+                SourceFileMapper mapper = _sourceFileMapper;
+                if (mapper == null)
                 {
-                    if (e.UseForBreakpoints && currentSrc.StartsWith(e.EditorPath, comp))
-                    {
-                        var file = currentSrc.Substring(e.EditorPath.Length);
-                        if (string.IsNullOrEmpty(file)) // matched the whole string
-                        {
-                            compilerSrc = e.CompileTimePath;  // return the matches compile time path
-                            return true;
-                        }
-                        // must do the path break at a directory boundry, i.e. at a '\' or '/' char
-                        char firstFilechar = file[0];
-                        char lastDirectoryChar = e.EditorPath[e.EditorPath.Length - 1];
-                        if (firstFilechar == Path.DirectorySeparatorChar || firstFilechar == Path.AltDirectorySeparatorChar)
-                        {
-                            file = file.Trim(new char[] { Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar });   // Trim the directory separator(s)
-                        }
-                        else if (lastDirectoryChar != Path.DirectorySeparatorChar && lastDirectoryChar != Path.AltDirectorySeparatorChar)
-                        {
-                            continue;   // match didn't end at a directory separator, not actually a match
-                        }
-                        compilerSrc = Path.Combine(e.CompileTimePath, file);    // map to the compiled location
-                        if (compilerSrc.IndexOf('\\') != -1)
-                        {
-                            compilerSrc = PlatformUtilities.WindowsPathToUnixPath(compilerSrc); // use Unix notation for the compiled path
-                        }
-                        return true;
-                    }
+                    mapper = new SourceFileMapper(_launchOptions.SourceMap, editorPathsIgnoreCase: PlatformUtilities.IsWindows(), compileTimePathsIgnoreCase: !_launchOptions.UseUnixSymbolPaths);
+                    _sourceFileMapper = mapper;
                 }
+                return mapper;
+            }
+        }
+
+        public bool MapCurrentSrcToCompileTimeSrc(string currentSrc, out string compilerSrc)
+        {
+            if (_launchOptions.SourceMap != null)
+            {
+                return SourceFileMapper.MapCurrentToCompileTime(currentSrc, out compilerSrc);
             }
             compilerSrc = currentSrc;
             return false;
@@ -2410,44 +2797,9 @@ namespace Microsoft.MIDebugEngine
             {
                 // Convert to Client source paths
                 string hostOSCompilerSrc = PlatformUtilities.PathToHostOSPath(compilerSrc);
-
-                StringComparison comp = _launchOptions.UseUnixSymbolPaths ? StringComparison.Ordinal : StringComparison.OrdinalIgnoreCase;
-                foreach (var e in _launchOptions.SourceMap)
+                if (SourceFileMapper.MapCompileTimeToCurrent(hostOSCompilerSrc, out currentName))
                 {
-                    if (string.IsNullOrEmpty(e.CompileTimePath))
-                    {
-                        continue;   // don't try to map back if path has an empty compiler src tree
-                    }
-                    if (hostOSCompilerSrc.StartsWith(e.CompileTimePath, comp))
-                    {
-                        var file = hostOSCompilerSrc.Substring(e.CompileTimePath.Length);
-                        if (string.IsNullOrEmpty(file)) // matched the whole string
-                        {
-                            if (hostOSCompilerSrc.EndsWith(Path.DirectorySeparatorChar.ToString(), StringComparison.Ordinal) || hostOSCompilerSrc.EndsWith(Path.AltDirectorySeparatorChar.ToString(), StringComparison.Ordinal))
-                            {
-                                break;  // directory matched, use default.
-                            }
-                            else
-                            {
-                                // Is a file
-                                currentName = e.EditorPath;  // return the matches compile time path
-                                return true;
-                            }
-                        }
-                        // must do the path break at a directory boundry, i.e. at a '\' or '/' char
-                        char firstFilechar = file[0];
-                        char lastDirectoryChar = e.CompileTimePath[e.CompileTimePath.Length - 1];
-                        if (file[0] == Path.DirectorySeparatorChar || file[0] == Path.AltDirectorySeparatorChar)
-                        {
-                            file = file.Trim(new char[] { Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar });   // Trim the directory separator(s)
-                        }
-                        else if (lastDirectoryChar != Path.DirectorySeparatorChar && lastDirectoryChar != Path.AltDirectorySeparatorChar)
-                        {
-                            continue;   // match didn't end at a directory separator, not actually a match
-                        }
-                        currentName = Path.Combine(e.EditorPath, file);    // map to the compiled location
-                        return true;
-                    }
+                    return true;
                 }
             }
             currentName = compilerSrc;
@@ -2460,11 +2812,29 @@ namespace Microsoft.MIDebugEngine
             string currentName = string.Empty;
             if (!string.IsNullOrEmpty(file))
             {
+                lock (_mappedFileNames)
+                {
+                    if (_mappedFileNames.TryGetValue(file, out currentName))
+                    {
+                        return currentName;
+                    }
+                }
+
+                string rawFile = file;
                 if (IsCygwin)
                 {
                     file = CygwinFilePathMapper.MapCygwinToWindows(file);
                 }
                 MapCompileTimeSrcToCurrentSrc(file, out currentName);
+
+                lock (_mappedFileNames)
+                {
+                    if (_mappedFileNames.Count >= MaxMappedFileNames)
+                    {
+                        _mappedFileNames.Clear();
+                    }
+                    _mappedFileNames[rawFile] = currentName;
+                }
             }
             return currentName;
         }
@@ -37,8 +37,12 @@ namespace Microsoft.MIDebugEngine
         private List<DebuggedThread> _threadList;
         private Dictionary<int, List<ThreadContext>> _stackFrames;
         private Dictionary<int, ThreadContext> _topContext;    // can retrieve the top frame without walking the stack
-        private bool _stateChange;             // indicates that a thread has been created/destroyed since last thread-info
+        private Dictionary<int, List<ThreadContext>> _partialStacks;   // first frames of stacks that have only been walked in part
+        private Dictionary<int, uint> _stackDepths;     // results of -stack-info-depth
+        private bool _stateChange;             // indicates that the thread list may be out of sync and needs a full -thread-info
         private bool _full;                    // indicates whether the cache has already been filled via -thread-info
+        private HashSet<int> _unnamedThreads;  // threads whose name was read when they were created, usually before the program names them
+        private int _lazyContextFetches;       // number of single thread -thread-info requests since the last break
         private ISampleEngineCallback _callback;
         private DebuggedProcess _debugger;
         private List<DebuggedThread> _deadThreads;
@@ -46,6 +50,11 @@ namespace Microsoft.MIDebugEngine
         private Dictionary<string, List<int>> _threadGroups;
         private static uint s_targetId = uint.MaxValue;
         private const string c_defaultGroupId = "i1";  // gdb's default group id, also used for any process without group ids
+        // Once this many threads have had their location requested individually in one break, fetch the rest
+        // with a single -thread-info instead (e.g. the UI is showing locations for every thread).
+        private const int c_maxLazyContextFetches = 16;
+        private const uint c_maxStackFrame = 1000;     // highest frame level walked
+        internal const uint StackPageSize = 20;        // minimum number of frames fetched by a paged stack walk
 
         private List<DebuggedThread> DeadThreads
         {
@@ -76,8 +85,11 @@ namespace Microsoft.MIDebugEngine
             _threadList = new List<DebuggedThread>();
             _stackFrames = new Dictionary<int, List<ThreadContext>>();
             _topContext = new Dictionary<int, ThreadContext>();
+            _partialStacks = new Dictionary<int, List<ThreadContext>>();
+            _stackDepths = new Dictionary<int, uint>();
             _threadGroups = new Dictionary<string, List<int>>();
             _threadGroups[c_defaultGroupId] = new List<int>();  // initialize the processes thread group
+            _unnamedThreads = new HashSet<int>();
             _stateChange = true;
             _callback = callback;
             _debugger = debugger;
@@ -87,16 +99,32 @@ namespace Microsoft.MIDebugEngine
 
         internal async Task<DebuggedThread[]> GetThreads()
         {
-            bool stateChange = false;
+            bool collect = false;
+            int[] unnamed = null;
             lock (_threadList)
             {
-                stateChange = _stateChange;
+                collect = _stateChange;
+                if (!collect && _unnamedThreads.Count != 0 && _debugger.ProcessState == ProcessState.Stopped)
+                {
+                    // Threads were created since the names were last read, so they may have been named since, e.g. by
+                    // pthread_setname_np. Refresh just those, unless there are so many that one -thread-info is cheaper.
+                    collect = _unnamedThreads.Count > c_maxLazyContextFetches;
+                    unnamed = _unnamedThreads.ToArray();
+                    _unnamedThreads.Clear();
+                }
             }
 
-            if (stateChange)
+            if (collect)
             {
                 await CollectThreadsInfo(0);
             }
+            else if (unnamed != null)
+            {
+                foreach (int id in unnamed)
+                {
+                    await CollectThreadInfo(id);
+                }
+            }
 
             lock (_threadList)
             {
@@ -106,15 +134,32 @@ namespace Microsoft.MIDebugEngine
 
         internal async Task<DebuggedThread> GetThread(int id)
         {
-            DebuggedThread[] threads = await GetThreads();
-            foreach (var t in threads)
+            bool stateChange = false;
+            lock (_threadList)
             {
-                if (t.Id == id)
+                stateChange = _stateChange;
+            }
+
+            if (stateChange)
+            {
+                await CollectThreadsInfo(0);
+            }
+
+            lock (_threadList)
+            {
+                DebuggedThread thread = _threadList.Find(t => t.Id == id);
+                if (thread != null)
                 {
-                    return t;
+                    return thread;
                 }
             }
-            return null;
+
+            // The thread list is maintained from =thread-created/=thread-exited, ask about a thread we haven't heard of
+            await CollectThreadInfo(id);
+            lock (_threadList)
+            {
+                return _threadList.Find(t => t.Id == id);
+            }
         }
 
         internal async Task<List<ThreadContext>> StackFrames(DebuggedThread thread)
@@ -143,16 +188,156 @@ namespace Microsoft.MIDebugEngine
             lock (_threadList)
             {
                 _stackFrames[thread.Id] = stack;
+                _partialStacks.Remove(thread.Id);
                 _topContext[thread.Id] = (stack != null && stack.Count > 0) ? stack[0] : null;
                 return _stackFrames[thread.Id];
             }
         }
 
+        /// <summary>
+        /// Walk the first frames of the thread's stack, continuing a previous partial walk from the same break.
+        /// </summary>
+        /// <param name="thread">thread to walk</param>
+        /// <param name="count">minimum number of frames wanted</param>
+        /// <returns>
+        /// A copy of at least 'count' frames from the top of the stack, or fewer if the stack is shorter, in which case
+        /// 'complete' is set. Frames is null if the stack couldn't be walked.
+        /// </returns>
+        internal async Task<(List<ThreadContext> frames, bool complete)> StackFramesPrefix(DebuggedThread thread, uint count)
+        {
+            List<ThreadContext> partial;
+            lock (_threadList)
+            {
+                if (!_threadList.Contains(thread))
+                {
+                    return (null, true);    // thread must be dead
+                }
+                if (_stackFrames.TryGetValue(thread.Id, out List<ThreadContext> stack))
+                {
+                    return (stack != null ? new List<ThreadContext>(stack) : null, true);
+                }
+                if (_partialStacks.TryGetValue(thread.Id, out partial) && partial.Count >= count)
+                {
+                    return (new List<ThreadContext>(partial), false);
+                }
+            }
+
+            uint low = partial != null ? (uint)partial.Count : 0;
+            uint high = Math.Min(Math.Max(count, low + StackPageSize) - 1, c_maxStackFrame);
+            TupleValue[] frameinfo = null;
+            bool symbolsLoaded = false;
+            try
+            {
+                frameinfo = await _debugger.MICommandFactory.StackListFrames(thread.Id, low, high);
+                while (frameinfo != null && await _debugger.LoadSymbolsForFrames(frameinfo))
+                {
+                    // The frames need names and source positions from the new symbols, and so do any cached earlier frames.
+                    // Without symbols gdb may also have stopped unwinding early, so repeat until no more modules need loading.
+                    // Other threads' frames are dropped once this walk is done, as their walks may be using them now.
+                    symbolsLoaded = true;
+                    lock (_threadList)
+                    {
+                        ForgetFrames(thread.Id);
+                    }
+                    low = 0;
+                    frameinfo = await _debugger.MICommandFactory.StackListFrames(thread.Id, low, high);
+                }
+            }
+            catch (UnexpectedMIResultException)
+            {
+                _debugger.Logger.WriteLine(LogLevel.Error, "Stack walk failed on thread: " + thread.TargetId);
+                _stateChange = true;   // thread may have been deleted. Force a resync
+            }
+
+            lock (_threadList)
+            {
+                if (_stackFrames.TryGetValue(thread.Id, out List<ThreadContext> stack))
+                {
+                    // completed by another request while this one was running
+                    return (stack != null ? new List<ThreadContext>(stack) : null, true);
+                }
+                _partialStacks.TryGetValue(thread.Id, out partial);
+                if (partial == null)
+                {
+                    partial = new List<ThreadContext>();
+                }
+                if (frameinfo == null)
+                {
+                    if (partial.Count == 0)
+                    {
+                        _stackFrames[thread.Id] = null;
+                        _topContext[thread.Id] = null;
+                        return (null, true);
+                    }
+                    return (new List<ThreadContext>(partial), true);
+                }
+                if (partial.Count == low)
+                {
+                    if (symbolsLoaded)
+                    {
+                        ForgetOtherThreadsFrames(thread.Id);
+                    }
+                    partial.AddRange(frameinfo.Select(frame => CreateContext(frame)));
+
+                    bool complete = frameinfo.Length < high - low + 1 || high == c_maxStackFrame;
+                    if (complete)
+                    {
+                        _partialStacks.Remove(thread.Id);
+                        _stackFrames[thread.Id] = partial;
+                    }
+                    else
+                    {
+                        _partialStacks[thread.Id] = partial;
+                    }
+                    if (!_topContext.ContainsKey(thread.Id) || _topContext[thread.Id] == null)
+                    {
+                        _topContext[thread.Id] = partial.Count > 0 ? partial[0] : null;
+                    }
+                    return (new List<ThreadContext>(partial), complete);
+                }
+            }
+
+            // Another request extended or reset the cached frames while this one was walking, so these frames don't
+            // line up with them. Start over from what is cached now.
+            return await StackFramesPrefix(thread, count);
+        }
+
+        /// <summary>
+        /// Number of frames on the thread's stack, using the cheaper -stack-info-depth when the stack hasn't been walked.
+        /// </summary>
+        internal async Task<uint?> StackDepth(DebuggedThread thread)
+        {
+            lock (_threadList)
+            {
+                if (_stackFrames.TryGetValue(thread.Id, out List<ThreadContext> stack) && stack != null)
+                {
+                    return (uint)stack.Count;
+                }
+                if (_stackDepths.TryGetValue(thread.Id, out uint cached))
+                {
+                    return cached;
+                }
+            }
+
+            Results results = await _debugger.MICommandFactory.StackInfoDepth(thread.Id, (int)c_maxStackFrame + 1, ResultClass.None);
+            if (results.ResultClass != ResultClass.done)
+            {
+                return null;
+            }
+            uint depth = results.FindUint("depth");
+            lock (_threadList)
+            {
+                _stackDepths[thread.Id] = depth;
+            }
+            return depth;
+        }
+
         internal async Task<ThreadContext> GetThreadContext(DebuggedThread thread)
         {
             if (thread == null)
                 return null;
 
+            bool collectAll;
             lock (_threadList)
             {
                 if (_topContext.ContainsKey(thread.Id))
@@ -163,9 +348,37 @@ namespace Microsoft.MIDebugEngine
                 {
                     return null;    // no context available for this thread
                 }
+                collectAll = _lazyContextFetches >= c_maxLazyContextFetches;
+                _lazyContextFetches++;
             }
 
-            return await CollectThreadsInfo(thread.Id);
+            if (collectAll)
+            {
+                return await CollectThreadsInfo(thread.Id);
+            }
+            return await CollectThreadInfo(thread.Id);
+        }
+
+        // Drops the cached frames of one thread, call with _threadList locked
+        private void ForgetFrames(int threadId)
+        {
+            _topContext.Remove(threadId);
+            _stackFrames.Remove(threadId);
+            _partialStacks.Remove(threadId);
+            _stackDepths.Remove(threadId);
+
+            // The cache no longer holds every thread's context, so let GetThreadContext fetch it again
+            _full = false;
+            _lazyContextFetches = 0;
+        }
+
+        // Drops the cached frames of every thread but one, which were walked before symbols were loaded. Call with _threadList locked
+        private void ForgetOtherThreadsFrames(int threadId)
+        {
+            foreach (int id in _topContext.Keys.Union(_stackFrames.Keys).Union(_partialStacks.Keys).Where(id => id != threadId).ToList())
+            {
+                ForgetFrames(id);
+            }
         }
 
         internal void MarkDirty()
@@ -174,23 +387,17 @@ namespace Microsoft.MIDebugEngine
             {
                 _topContext.Clear();
                 _stackFrames.Clear();
+                _partialStacks.Clear();
+                _stackDepths.Clear();
                 _full = false;
+                _lazyContextFetches = 0;
             }
         }
 
         internal async Task ThreadCreatedEvent(int id, string groupId)
         {
-            // Mark that the threads have changed
             lock (_threadList)
             {
-                {
-                    var thread = _threadList.Find(t => t.Id == id);
-                    if (thread == null)
-                    {
-                        _stateChange = true;
-                    }
-                }
-
                 // This must go before getting the thread-info for the thread since that method call is async.
                 // The threadId must be added to the thread-group before the new thread is created or else it will
                 // be marked as a child thread and then thread-created and thread-exited won't be sent to the UI
@@ -242,10 +449,19 @@ namespace Microsoft.MIDebugEngine
                     if (bNew)
                     {
                         NewThreads.Add(thread);
+                        _unnamedThreads.Add(id);
                         SendThreadEvents(null, null);
                     }
                 }
             }
+            else
+            {
+                lock (_threadList)
+                {
+                    // couldn't add the thread from its event, resync the whole list when it is next needed
+                    _stateChange = true;
+                }
+            }
         }
 
         internal void ThreadExitedEvent(int id)
@@ -258,8 +474,9 @@ namespace Microsoft.MIDebugEngine
                 {
                     DeadThreads.Add(thread);
                     _threadList.Remove(thread);
-                    _stateChange = true;
                 }
+                ForgetFrames(id);
+                _unnamedThreads.Remove(id);
                 foreach (var g in _threadGroups)
                 {
                     if (g.Value.Contains(id))
@@ -292,7 +509,21 @@ namespace Microsoft.MIDebugEngine
         private async Task<List<ThreadContext>> WalkStack(DebuggedThread thread)
         {
             List<ThreadContext> stack = null;
+            bool symbolsLoaded = false;
             TupleValue[] frameinfo = await _debugger.MICommandFactory.StackListFrames(thread.Id, 0, 1000);
+            while (frameinfo != null && await _debugger.LoadSymbolsForFrames(frameinfo))
+            {
+                // Walk again to get names, source positions and any frames gdb couldn't unwind without the new symbols
+                symbolsLoaded = true;
+                frameinfo = await _debugger.MICommandFactory.StackListFrames(thread.Id, 0, 1000);
+            }
+            if (symbolsLoaded)
+            {
+                lock (_threadList)
+                {
+                    ForgetOtherThreadsFrames(thread.Id);
+                }
+            }
             if (frameinfo == null)
             {
                 _debugger.Logger.WriteLine(LogLevel.Error, "Failed to get frame info");
@@ -411,6 +642,51 @@ namespace Microsoft.MIDebugEngine
             return thread;
         }
 
+        /// <summary>
+        /// Refresh a single thread with -thread-info &lt;id&gt; and return its top frame.
+        /// </summary>
+        private async Task<ThreadContext> CollectThreadInfo(int threadId)
+        {
+            if (threadId < 0)
+            {
+                return null;
+            }
+            Results results = await _debugger.MICommandFactory.ThreadInfo((uint)threadId);
+            if (results.ResultClass != ResultClass.done)
+            {
+                return null;
+            }
+
+            var tlist = results.Find<ValueListValue>("threads");
+            ResultValue resVal = tlist.Content.FirstOrDefault(item => item.FindInt("id") == threadId);
+            if (resVal == null)
+            {
+                return null;    // the thread has exited
+            }
+
+            lock (_threadList)
+            {
+                bool bNew = false;
+                var thread = SetThreadInfoFromResultValue(resVal, out bNew);
+                if (bNew)
+                {
+                    NewThreads.Add(thread);
+                }
+
+                TupleValue frame = ((TupleValue)resVal).FindAll<TupleValue>("frame").FirstOrDefault();
+                if (frame == null)
+                {
+                    return null;
+                }
+                if (!_topContext.TryGetValue(threadId, out ThreadContext cxt))
+                {
+                    cxt = CreateContext(frame);
+                    _topContext[threadId] = cxt;
+                }
+                return cxt;
+            }
+        }
+
         private async Task<ThreadContext> CollectThreadsInfo(int cxtThreadId)
         {
             ThreadContext ret = null;
@@ -475,6 +751,7 @@ namespace Microsoft.MIDebugEngine
 
                     _stateChange = false;
                     _full = true;
+                    _unnamedThreads.Clear();
                 }
             }
             return ret;
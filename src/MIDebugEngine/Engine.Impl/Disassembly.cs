@@ -25,107 +25,348 @@ namespace Microsoft.MIDebugEngine
         public uint Line;
         public uint OffsetInLine;
     };
+    /// <summary>
+    /// A run of contiguous decoded instructions. The instruction addresses are kept in their own sorted array so the
+    /// instruction containing an address is found with a binary search.
+    /// </summary>
     internal class DisassemblyBlock
     {
-        static private long s_touchCount = 0;
-        internal long Touch;
-
         private readonly DisasmInstruction[] _instructions;
+        private readonly ulong[] _addresses;
+
+        internal LinkedListNode<DisassemblyBlock> LruNode;
 
-        private int FindIndex(ulong addr)
+        public DisassemblyBlock(DisasmInstruction[] ins)
         {
-            // allow addresses within an instruction to match the instruction
-            for (int i = 0; i < _instructions.Length - 1; ++i)
+            Debug.Assert(ins.Length > 0, "Empty disassembly block");
+            _instructions = ins;
+            _addresses = new ulong[ins.Length];
+            for (int i = 0; i < ins.Length; i++)
             {
-                if (_instructions[i].Addr <= addr && _instructions[i + 1].Addr > addr)
-                {
-                    return i;
-                }
+                _addresses[i] = ins[i].Addr;
             }
-            if (_instructions[_instructions.Length - 1].Addr == addr)
+            DisasmInstruction last = ins[ins.Length - 1];
+            End = last.Addr + Math.Max(InstructionLength(last), 1);
+        }
+
+        internal DisasmInstruction[] Instructions { get { return _instructions; } }
+        internal ulong Address { get { return _addresses[0]; } }
+        internal int Count { get { return _instructions.Length; } }
+
+        /// <summary>
+        /// First address after the block. If the length of the last instruction is unknown this is the address after
+        /// its first byte.
+        /// </summary>
+        internal ulong End { get; private set; }
+
+        /// <summary>
+        /// Returns the index of the instruction containing <paramref name="addr"/>, or -1 if it isn't in the block.
+        /// </summary>
+        internal int FindIndex(ulong addr)
+        {
+            if (addr < Address || addr >= End)
             {
-                return _instructions.Length - 1;
+                return -1;
             }
+            int i = Array.BinarySearch(_addresses, addr);
+            return i >= 0 ? i : ~i - 1;     // allow addresses within an instruction to match the instruction
+        }
 
-            return -1;
+        /// <summary>
+        /// Returns the first address after instruction <paramref name="index"/>.
+        /// </summary>
+        internal ulong EndOf(int index)
+        {
+            return index + 1 < _addresses.Length ? _addresses[index + 1] : End;
         }
 
-        internal ulong Address { get { return _instructions[0].Addr; } }
-        internal int Count { get { return _instructions.Length; } }
+        internal DisassemblyBlock Slice(int start, int count)
+        {
+            DisasmInstruction[] ins = new DisasmInstruction[count];
+            Array.Copy(_instructions, start, ins, 0, count);
+            return new DisassemblyBlock(ins);
+        }
 
-        public bool Contains(ulong addr, int cnt)
+        private static uint InstructionLength(DisasmInstruction instruction)
         {
-            if (_instructions.Length == 0)
-                return false;
-            if (_instructions[0].Addr > addr || addr > _instructions[_instructions.Length - 1].Addr)
-                return false;
-            int i = FindIndex(addr);
-            if (i < 0)
+            // opcodes are hex bytes, either separated by spaces ("48 89 e5") or grouped into words ("d503201f")
+            if (string.IsNullOrEmpty(instruction.CodeBytes))
             {
-                return false;
+                return 0;
             }
-            i += cnt;
-            Touch = Interlocked.Increment(ref s_touchCount);
-            return 0 <= i && i <= _instructions.Length;
+            uint digits = 0;
+            foreach (char c in instruction.CodeBytes)
+            {
+                if (Uri.IsHexDigit(c))
+                {
+                    digits++;
+                }
+            }
+            return digits / 2;
         }
+    }
+
+    /// <summary>
+    /// Cache of decoded instructions. Decoded ranges are kept in address order without overlaps, and adjacent ranges
+    /// are merged, so lookups can run across the boundaries of separate disassembly requests in either direction.
+    /// Least recently used ranges are evicted once the cache holds more than a given number of instructions.
+    /// Not thread safe.
+    /// </summary>
+    internal class DisassemblyCache
+    {
+        internal const int MaxBlockSize = 4096;     // adjacent blocks aren't merged beyond this many instructions
+
+        private readonly int _maxInstructions;
+        private readonly List<DisassemblyBlock> _blocks = new List<DisassemblyBlock>();     // sorted by address
+        private readonly LinkedList<DisassemblyBlock> _lru = new LinkedList<DisassemblyBlock>(); // most recently used first
+
+        public DisassemblyCache(int maxInstructions)
+        {
+            _maxInstructions = maxInstructions;
+        }
+
+        public int InstructionCount { get; private set; }
+        public int BlockCount { get { return _blocks.Count; } }
 
+        /// <summary>
+        /// Adds decoded instructions, which must be sorted and contiguous. Cached instructions they overlap are
+        /// replaced.
+        /// </summary>
+        public void Add(DisasmInstruction[] instructions)
+        {
+            if (instructions == null || instructions.Length == 0)
+            {
+                return;
+            }
+            DisassemblyBlock block = new DisassemblyBlock(instructions);
+
+            // Trim the blocks the new one overlaps, keeping only whole instructions outside of it
+            int i = FirstBlockEndingAfter(block.Address);
+            while (i < _blocks.Count && _blocks[i].Address < block.End)
+            {
+                DisassemblyBlock old = _blocks[i];
+                int before = 0;
+                while (before < old.Count && old.EndOf(before) <= block.Address)
+                {
+                    before++;
+                }
+                int after = before;
+                while (after < old.Count && old.Instructions[after].Addr < block.End)
+                {
+                    after++;
+                }
+
+                _blocks.RemoveAt(i);
+                InstructionCount -= old.Count;
+                if (before > 0)
+                {
+                    Insert(i++, old.Slice(0, before), old.LruNode);
+                }
+                if (after < old.Count)
+                {
+                    Insert(i++, old.Slice(after, old.Count - after), old.LruNode);
+                }
+                _lru.Remove(old.LruNode);
+            }
+
+            i = FirstBlockEndingAfter(block.Address);
+            Insert(i, block, null);
+            i = MergeWithNext(i);
+            if (i > 0)
+            {
+                MergeWithNext(i - 1);
+            }
+
+            // Evict, but never the block that was just added
+            while (InstructionCount > _maxInstructions && _lru.Count > 1)
+            {
+                _blocks.Remove(_lru.Last.Value);
+                InstructionCount -= _lru.Last.Value.Count;
+                _lru.RemoveLast();
+            }
+        }
+
+        /// <summary>
+        /// Looks up cached instructions starting at the instruction containing <paramref name="addr"/>.
+        /// </summary>
+        /// <param name="addr">Address of the first instruction</param>
+        /// <param name="cnt">Number of instructions. If negative, the instructions preceding the one containing
+        /// <paramref name="addr"/> are returned.</param>
+        /// <returns>True if all the instructions are cached</returns>
         public bool TryFetch(ulong addr, int cnt, out ICollection<DisasmInstruction> instructions)
         {
             instructions = null;
-            if (!Contains(addr, cnt))
+            int b = FindBlock(addr);
+            if (b < 0)
+            {
                 return false;
-            int i = FindIndex(addr);
-            if (cnt < 0)
+            }
+            int index = _blocks[b].FindIndex(addr);
+
+            int first = b, last = b;
+            if (cnt >= 0)
+            {
+                // walk forward over adjacent blocks until there are enough instructions
+                int available = _blocks[b].Count - index;
+                while (available < cnt)
+                {
+                    if (last + 1 >= _blocks.Count || _blocks[last + 1].Address != _blocks[last].End)
+                    {
+                        return false;
+                    }
+                    available += _blocks[++last].Count;
+                }
+            }
+            else
             {
-                i = i + cnt;
-                cnt = -cnt;
+                int available = index;
+                while (available < -cnt)
+                {
+                    if (first == 0 || _blocks[first - 1].End != _blocks[first].Address)
+                    {
+                        return false;
+                    }
+                    available += _blocks[--first].Count;
+                }
+            }
+
+            for (int j = first; j <= last; j++)
+            {
+                Touch(_blocks[j]);
+            }
+
+            if (first == last)
+            {
+                int start = cnt >= 0 ? index : index + cnt;
+                instructions = new ArraySegment<DisasmInstruction>(_blocks[b].Instructions, start, Math.Abs(cnt));
+                return true;
+            }
+
+            List<DisasmInstruction> ret = new List<DisasmInstruction>(Math.Abs(cnt));
+            if (cnt >= 0)
+            {
+                for (int j = first; j <= last && ret.Count < cnt; j++)
+                {
+                    int start = j == first ? index : 0;
+                    int take = Math.Min(_blocks[j].Count - start, cnt - ret.Count);
+                    ret.AddRange(new ArraySegment<DisasmInstruction>(_blocks[j].Instructions, start, take));
+                }
+            }
+            else
+            {
+                int skip = -cnt;
+                for (int j = first; j <= last; j++)
+                {
+                    skip -= j == last ? index : _blocks[j].Count;
+                }
+                skip = -skip;   // instructions of the first block which aren't wanted
+                for (int j = first; j <= last; j++)
+                {
+                    int start = j == first ? skip : 0;
+                    int end = j == last ? index : _blocks[j].Count;
+                    ret.AddRange(new ArraySegment<DisasmInstruction>(_blocks[j].Instructions, start, end - start));
+                }
             }
-            instructions = new ArraySegment<DisasmInstruction>(_instructions, i, cnt);
+            instructions = ret;
             return true;
         }
 
-        public bool TryFetch(ulong startAddr, ulong endAddr, out ICollection<DisasmInstruction> instructions)
+        private int FindBlock(ulong addr)
         {
-            instructions = null;
-            if (!Contains(startAddr, 1))
-                return false;
-            if (!Contains(endAddr, 1))
-                return false;
-            int i = FindIndex(startAddr);
-            int j = FindIndex(endAddr);
-            instructions = new ArraySegment<DisasmInstruction>(_instructions, i, j-i);
-            return true;
+            int i = FirstBlockEndingAfter(addr);
+            return i < _blocks.Count && _blocks[i].Address <= addr ? i : -1;
         }
 
-        public DisasmInstruction At(ulong addr)
+        private int FirstBlockEndingAfter(ulong addr)
         {
-            Debug.Assert(Contains(addr, 1), "Address not in block");
-            Touch = ++s_touchCount;
-            for (int i = 0; i < _instructions.Length; ++i)
+            int lo = 0, hi = _blocks.Count;
+            while (lo < hi)
             {
-                if (_instructions[i].Addr == addr)
+                int mid = lo + (hi - lo) / 2;
+                if (_blocks[mid].End <= addr)
                 {
-                    return _instructions[i];
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
                 }
             }
-            return null;
+            return lo;
         }
-        public DisassemblyBlock(DisasmInstruction[] ins)
+
+        /// <summary>
+        /// Merges block <paramref name="i"/> with the following block if they are adjacent and small enough.
+        /// </summary>
+        /// <returns>The index of the block which now contains block i</returns>
+        private int MergeWithNext(int i)
         {
-            Touch = ++s_touchCount;
-            _instructions = ins;
+            if (i + 1 >= _blocks.Count)
+            {
+                return i;
+            }
+            DisassemblyBlock a = _blocks[i], b = _blocks[i + 1];
+            if (a.End != b.Address || a.Count + b.Count > MaxBlockSize)
+            {
+                return i;
+            }
+
+            DisasmInstruction[] ins = new DisasmInstruction[a.Count + b.Count];
+            a.Instructions.CopyTo(ins, 0);
+            b.Instructions.CopyTo(ins, a.Count);
+
+            // The merged block is as recent as the more recent of the two
+            LinkedListNode<DisassemblyBlock> position = a.LruNode;
+            for (var n = _lru.First; n != null; n = n.Next)
+            {
+                if (n == a.LruNode || n == b.LruNode)
+                {
+                    position = n;
+                    break;
+                }
+            }
+            DisassemblyBlock merged = new DisassemblyBlock(ins);
+            merged.LruNode = _lru.AddBefore(position, merged);
+            RemoveAt(i + 1);
+            RemoveAt(i);
+            _blocks.Insert(i, merged);
+            InstructionCount += merged.Count;
+            return i;
+        }
+
+        private void Insert(int index, DisassemblyBlock block, LinkedListNode<DisassemblyBlock> lruPosition)
+        {
+            _blocks.Insert(index, block);
+            InstructionCount += block.Count;
+            block.LruNode = lruPosition != null ? _lru.AddBefore(lruPosition, block) : _lru.AddFirst(block);
+        }
+
+        private void RemoveAt(int index)
+        {
+            DisassemblyBlock block = _blocks[index];
+            _blocks.RemoveAt(index);
+            InstructionCount -= block.Count;
+            _lru.Remove(block.LruNode);
+        }
+
+        private void Touch(DisassemblyBlock block)
+        {
+            _lru.Remove(block.LruNode);
+            _lru.AddFirst(block.LruNode);
         }
     }
+
     internal class Disassembly
     {
-        private const int cacheSize = 10;   // number of cached blocks to keep
-        private SortedList<ulong, DisassemblyBlock> _disassemlyCache;
+        private const int CacheSize = 64 * 1024;    // number of cached instructions to keep
+        private const int ReadAhead = 2;            // factor by which to widen fetches in the direction of a seek
+        private readonly DisassemblyCache _disassemlyCache;
         private DebuggedProcess _process;
 
         public Disassembly(DebuggedProcess process)
         {
             _process = process;
-            _disassemlyCache = new SortedList<ulong, DisassemblyBlock>();
+            _disassemlyCache = new DisassemblyCache(CacheSize);
         }
 
         private ICollection<DisasmInstruction> UpdateCache(ulong address, int nInstructions, DisasmInstruction[] instructions)
@@ -133,30 +374,11 @@ namespace Microsoft.MIDebugEngine
             ICollection<DisasmInstruction> ret = null;
             if (instructions != null && instructions.Length > 0)
             {
-                DisassemblyBlock block = new DisassemblyBlock(instructions);
                 lock (_disassemlyCache)
                 {
-                    // push to the cache
-                    DeleteRangeFromCache(block);    // removes any entry with the same key
-                    if (_disassemlyCache.Count >= cacheSize)
-                    {
-                        long max = 0;
-                        int toDelete = -1;
-                        for (int i = 0; i < _disassemlyCache.Count; ++i)
-                        {
-                            var e = _disassemlyCache.ElementAt(i);
-                            if (e.Value.Touch > max)
-                            {
-                                max = e.Value.Touch;
-                                toDelete = i;
-                            }
-                        }
-                        Debug.Assert(toDelete >= 0, "Failed to flush from the cache");
-                        _disassemlyCache.RemoveAt(toDelete);
-                    }
-                    _disassemlyCache.Add(block.Address, block);
+                    _disassemlyCache.Add(instructions);
+                    _disassemlyCache.TryFetch(address, nInstructions, out ret);
                 }
-                var kv = block.TryFetch(address, nInstructions, out ret);
             }
             return ret;
         }
@@ -175,37 +397,37 @@ namespace Microsoft.MIDebugEngine
             lock (_disassemlyCache)
             {
                 // check the cache, look for it to contain nInstructions back from the address
-                var kv = _disassemlyCache.FirstOrDefault((p) => p.Value.TryFetch(address, -nInstructions, out ret));
-                if (kv.Value != null)
+                if (_disassemlyCache.TryFetch(address, -nInstructions, out ret))
                     return ret.First().Addr;
             }
+
+            // Scrolling up is likely to continue, so decode further back than asked for
+            int nFetch = nInstructions > 1 ? nInstructions * ReadAhead : nInstructions;
             ulong endAddress;
             ulong startAddress;
-            var range = await _process.FindValidMemoryRange(address, (uint)(_process.MaxInstructionSize * (nInstructions+1)), (int)(_process.MaxInstructionSize * -nInstructions));
+            var range = await _process.FindValidMemoryRange(address, (uint)(_process.MaxInstructionSize * (nFetch+1)), (int)(_process.MaxInstructionSize * -nFetch));
             startAddress = range.Item1;
             endAddress = range.Item2;
             if (endAddress - startAddress == 0 || address < startAddress) // bad address range, no instructions
             {
                 return defaultAddr;
             }
-            lock (_disassemlyCache)
+
+            DisasmInstruction[] instructions = await Disassemble(_process, startAddress, endAddress);
+            if (instructions == null)
             {
-                // check the cache with the adjusted range
-                var kv = _disassemlyCache.FirstOrDefault((p) => p.Value.TryFetch(startAddress, address < endAddress ? address : endAddress, out ret));
+                return defaultAddr;    // unknown error condition
             }
-            if (ret == null)
-            {
-                DisasmInstruction[] instructions = await Disassemble(_process, startAddress, endAddress);
-                if (instructions == null)
-                {
-                    return defaultAddr;    // unknown error condition
-                }
 
-                // when seeking back require that the disassembly contain an instruction at the target address (x86 has varying length instructions) 
-                instructions = await VerifyDisassembly(instructions, startAddress, endAddress, address);
+            // when seeking back require that the disassembly contain an instruction at the target address (x86 has varying length instructions) 
+            instructions = await VerifyDisassembly(instructions, startAddress, endAddress, address);
 
-                ret = UpdateCache(address, -nInstructions, instructions);
-                if (ret == null)
+            ret = UpdateCache(address, -nInstructions, instructions);
+            if (ret == null)
+            {
+                // fewer instructions than asked for, use the ones before the target address
+                ret = instructions.Where((i) => i.Addr < address).ToList();
+                if (ret.Count == 0)
                 {
                     return defaultAddr;
                 }
@@ -237,14 +459,15 @@ namespace Microsoft.MIDebugEngine
             lock (_disassemlyCache)
             {
                 // check the cache
-                var kv = _disassemlyCache.FirstOrDefault((p) => p.Value.TryFetch(address, nInstructions, out ret));
-                if (kv.Value != null)
+                if (_disassemlyCache.TryFetch(address, nInstructions, out ret))
                     return ret;
             }
 
+            // Scrolling down is likely to continue, so decode further ahead than asked for
+            int nFetch = nInstructions > 1 ? nInstructions * ReadAhead : nInstructions;
             ulong endAddress;
             ulong startAddress;
-            var range = await _process.FindValidMemoryRange(address, (uint)(_process.MaxInstructionSize * nInstructions), 0);
+            var range = await _process.FindValidMemoryRange(address, (uint)(_process.MaxInstructionSize * nFetch), 0);
             startAddress = range.Item1;
             endAddress = range.Item2;
             int gap = (int)(startAddress - address);   // num of bytes before instructions begin
@@ -263,8 +486,7 @@ namespace Microsoft.MIDebugEngine
             lock (_disassemlyCache)
             {
                 // re-check the cache with the verified memory range
-                var kv = _disassemlyCache.FirstOrDefault((p) => p.Value.TryFetch(startAddress, nInstructions, out ret));
-                if (kv.Value != null)
+                if (_disassemlyCache.TryFetch(startAddress, nInstructions, out ret))
                     return ret;
             }
 
@@ -292,19 +514,6 @@ namespace Microsoft.MIDebugEngine
             return instructions == null ? originalInstructions : instructions;
         }
 
-        private void DeleteRangeFromCache(DisassemblyBlock block)
-        {
-            for (int i = 0; i < _disassemlyCache.Count; ++i)
-            {
-                DisassemblyBlock elem = _disassemlyCache.ElementAt(i).Value;
-                if (block.Contains(elem.Address, elem.Count))
-                {
-                    _disassemlyCache.RemoveAt(i);
-                    break;
-                }
-            }
-        }
-
         // this is inefficient so we try and grab everything in one gulp
         internal static async Task<DisasmInstruction[]> Disassemble(DebuggedProcess process, ulong startAddr, ulong endAddr)
         {
@@ -21,6 +21,10 @@ namespace Microsoft.MIDebugEngine
         private const string Property_Windows_Runtime_Environment = @"VS.Diagnostics.Debugger.MIEngine.WindowsRuntime";
         private const string Value_Windows_Runtime_Environment_Cygwin = "Cygwin";
         private const string Value_Windows_Runtime_Environment_MinGW = "MinGW";
+        private const string Event_SymbolLoad = @"VS/Diagnostics/Debugger/MIEngine/SymbolLoad";
+        private const string Property_SymbolLoadTrigger = @"VS.Diagnostics.Debugger.MIEngine.SymbolLoadTrigger";
+        private const string Property_SymbolLoadDuration = @"VS.Diagnostics.Debugger.MIEngine.SymbolLoadDurationMs";
+        private const string Property_SymbolLoadOnDemand = @"VS.Diagnostics.Debugger.MIEngine.SymbolLoadOnDemand";
 
         public bool DecodeTelemetryEvent(Results results, out string eventName, out KeyValuePair<string, object>[] properties)
         {
@@ -87,6 +91,21 @@ namespace Microsoft.MIDebugEngine
             HostTelemetry.SendEvent(Event_DebuggerAborted, eventProperties.ToArray());
         }
 
+        public enum SymbolLoadTrigger
+        {
+            LibraryLoad,    // the library matched the symbol load settings when it loaded
+            StackFrame,     // a frame in the library was seen on a stack
+            User            // the user asked for the symbols
+        }
+
+        public void SendSymbolLoad(SymbolLoadTrigger trigger, long durationMs, bool onDemand)
+        {
+            HostTelemetry.SendEvent(Event_SymbolLoad,
+                new KeyValuePair<string, object>(Property_SymbolLoadTrigger, trigger.ToString()),
+                new KeyValuePair<string, object>(Property_SymbolLoadDuration, durationMs),
+                new KeyValuePair<string, object>(Property_SymbolLoadOnDemand, onDemand));
+        }
+
         public enum WindowsRuntimeEnvironment
         {
             Cygwin,
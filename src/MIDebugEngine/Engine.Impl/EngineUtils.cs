@@ -21,6 +21,54 @@ namespace Microsoft.MIDebugEngine
             return "0x" + addr.ToString(addrFormat, CultureInfo.InvariantCulture);
         }
 
+        private static readonly sbyte[] s_hexDigitValues = CreateHexDigitValues();
+
+        private static sbyte[] CreateHexDigitValues()
+        {
+            sbyte[] values = new sbyte[128];
+            for (int i = 0; i < values.Length; i++)
+            {
+                values[i] = -1;
+            }
+            for (int i = 0; i < 10; i++)
+            {
+                values['0' + i] = (sbyte)i;
+            }
+            for (int i = 0; i < 6; i++)
+            {
+                values['a' + i] = (sbyte)(10 + i);
+                values['A' + i] = (sbyte)(10 + i);
+            }
+            return values;
+        }
+
+        /// <summary>
+        /// Decodes a string of hex digit pairs (as returned by -data-read-memory-bytes) into a byte buffer.
+        /// </summary>
+        /// <param name="content">String of hex digits, two per byte</param>
+        /// <param name="bytes">Destination buffer</param>
+        /// <param name="offset">Index in bytes at which to write the first decoded byte</param>
+        /// <param name="count">Number of bytes to decode</param>
+        internal static void DecodeHexBytes(string content, byte[] bytes, int offset, int count)
+        {
+            if (content.Length < count * 2)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+
+            for (int pos = 0; pos < count; ++pos)
+            {
+                char high = content[pos * 2];
+                char low = content[pos * 2 + 1];
+                int value = high < 128 && low < 128 ? (s_hexDigitValues[high] << 4) | s_hexDigitValues[low] : -1;
+                if (value < 0)
+                {
+                    throw new FormatException();
+                }
+                bytes[offset + pos] = (byte)value;
+            }
+        }
+
         internal static string GetAddressDescription(DebuggedProcess proc, ulong ip)
         {
             string description = null;
@@ -0,0 +1,77 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System.Collections.Generic;
+
+namespace Microsoft.MIDebugEngine
+{
+    /// <summary>
+    /// A logpoint message the debugger can print by itself when the location is hit, instead of stopping the process for
+    /// the engine to evaluate and print it. Plain text is inserted as a dprintf. Messages with interpolations are inserted
+    /// as a python breakpoint whose stop method evaluates them in the debugger, so printing a value never calls into the
+    /// debuggee, see <see cref="MICore.MICommandFactory.LogpointInsert"/>.
+    /// </summary>
+    internal class Logpoint
+    {
+        /// <summary>
+        /// The message as alternating literal text and interpolations, starting and ending with text. The last text ends
+        /// with a newline.
+        /// </summary>
+        public IReadOnlyList<string> Parts { get; private set; }
+
+        /// <summary>
+        /// True if the message has no interpolations, so it can be printed with a dprintf
+        /// </summary>
+        public bool IsPlainText { get { return Parts.Count == 1; } }
+
+        /// <summary>
+        /// The printf format of a plain text message
+        /// </summary>
+        public string Format { get { return Parts[0].Replace("%", "%%"); } }
+
+        private Logpoint(List<string> parts)
+        {
+            Parts = parts;
+        }
+
+        /// <summary>
+        /// Compiles a message split into alternating literal text and interpolations ("{expression}" or "$TOKEN").
+        /// Returns null if the message uses something the debugger can't print, in which case the logpoint has to stop.
+        /// </summary>
+        public static Logpoint Compile(string[] parts)
+        {
+            if (parts == null || parts.Length == 0)
+            {
+                return null;
+            }
+
+            for (int i = 1; i < parts.Length; i += 2)
+            {
+                string part = parts[i];
+                if (part.Length > 2 && part[0] == '{' && part[part.Length - 1] == '}')
+                {
+                    continue;
+                }
+                switch (part)
+                {
+                    case "$FUNCTION":
+                    case "$TID":
+                    case "$PID":
+                        break;
+                    default:
+                        // The remaining tokens need the call stack or the host
+                        return null;
+                }
+            }
+
+            List<string> compiled = new List<string>(parts);
+            if (compiled.Count % 2 == 0)
+            {
+                compiled.Add(string.Empty);
+            }
+            compiled[compiled.Count - 1] += "\n";
+
+            return new Logpoint(compiled);
+        }
+    }
+}
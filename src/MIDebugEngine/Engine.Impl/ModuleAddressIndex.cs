@@ -0,0 +1,167 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+
+namespace Microsoft.MIDebugEngine
+{
+    /// <summary>
+    /// Immutable index of module address ranges, sorted by start address. Overlaps are resolved when the index is built,
+    /// so lookups are a binary search over disjoint segments and need no lock; updates build a new index which is then
+    /// published by replacing the reference.
+    /// </summary>
+    internal sealed class ModuleAddressIndex
+    {
+        public static readonly ModuleAddressIndex Empty = new ModuleAddressIndex(new Range[0]);
+
+        private struct Range
+        {
+            public ulong Start;
+            public ulong End;       // exclusive
+            public uint Order;      // load order of the module, lowest wins on overlap
+            public DebuggedModule Module;
+        }
+
+        private struct Segment
+        {
+            public ulong Start;
+            public ulong End;       // exclusive
+            public DebuggedModule Module;
+        }
+
+        private readonly Range[] _ranges;       // kept for building the next index
+        private readonly Segment[] _segments;   // disjoint and sorted, each resolved to the module an address in it belongs to
+
+        private ModuleAddressIndex(Range[] ranges)
+        {
+            _ranges = ranges;
+            _segments = Resolve(ranges);
+        }
+
+        // Sweeps the range boundaries in address order, keeping the ranges that cover the current address sorted by load order
+        private static Segment[] Resolve(Range[] ranges)
+        {
+            List<Segment> segments = new List<Segment>();
+            SortedSet<(uint Order, int Index)> covering = new SortedSet<(uint Order, int Index)>();
+            SortedSet<(ulong End, int Index)> ends = new SortedSet<(ulong End, int Index)>();
+            int next = 0;
+            ulong pos = 0;
+            while (next < ranges.Length || ends.Count != 0)
+            {
+                ulong boundary = next < ranges.Length ? ranges[next].Start : ulong.MaxValue;
+                if (ends.Count != 0 && ends.Min.End < boundary)
+                {
+                    boundary = ends.Min.End;
+                }
+
+                if (covering.Count != 0 && boundary > pos)
+                {
+                    DebuggedModule module = ranges[covering.Min.Index].Module;
+                    int last = segments.Count - 1;
+                    if (last >= 0 && segments[last].End == pos && segments[last].Module == module)
+                    {
+                        segments[last] = new Segment() { Start = segments[last].Start, End = boundary, Module = module };
+                    }
+                    else
+                    {
+                        segments.Add(new Segment() { Start = pos, End = boundary, Module = module });
+                    }
+                }
+                pos = boundary;
+
+                while (ends.Count != 0 && ends.Min.End == boundary)
+                {
+                    int ended = ends.Min.Index;
+                    ends.Remove(ends.Min);
+                    covering.Remove((ranges[ended].Order, ended));
+                }
+                for (; next < ranges.Length && ranges[next].Start == boundary; next++)
+                {
+                    if (ranges[next].End > ranges[next].Start)
+                    {
+                        covering.Add((ranges[next].Order, next));
+                        ends.Add((ranges[next].End, next));
+                    }
+                }
+            }
+            return segments.ToArray();
+        }
+
+        public int Count { get { return _ranges.Length; } }
+
+        /// <summary>
+        /// Returns a new index which also contains the sections of <paramref name="module"/>.
+        /// </summary>
+        public ModuleAddressIndex Add(DebuggedModule module)
+        {
+            List<Range> added = new List<Range>();
+            foreach (var range in module.AddressRanges())
+            {
+                added.Add(new Range() { Start = range.Key, End = range.Value, Order = module.GetLoadOrder(), Module = module });
+            }
+            if (added.Count == 0)
+            {
+                return this;
+            }
+            added.Sort((a, b) => a.Start.CompareTo(b.Start));
+
+            // Merge the two sorted lists
+            Range[] ranges = new Range[_ranges.Length + added.Count];
+            int i = 0, j = 0, k = 0;
+            while (i < _ranges.Length && j < added.Count)
+            {
+                ranges[k++] = _ranges[i].Start <= added[j].Start ? _ranges[i++] : added[j++];
+            }
+            while (i < _ranges.Length)
+            {
+                ranges[k++] = _ranges[i++];
+            }
+            while (j < added.Count)
+            {
+                ranges[k++] = added[j++];
+            }
+            return new ModuleAddressIndex(ranges);
+        }
+
+        /// <summary>
+        /// Returns a new index without the sections of <paramref name="module"/>.
+        /// </summary>
+        public ModuleAddressIndex Remove(DebuggedModule module)
+        {
+            List<Range> ranges = new List<Range>(_ranges.Length);
+            foreach (Range r in _ranges)
+            {
+                if (r.Module != module)
+                {
+                    ranges.Add(r);
+                }
+            }
+            return ranges.Count == _ranges.Length ? this : new ModuleAddressIndex(ranges.ToArray());
+        }
+
+        /// <summary>
+        /// Finds the module containing <paramref name="addr"/>. If more than one module claims the address the one
+        /// loaded first is returned, matching a linear search of the module list.
+        /// </summary>
+        public DebuggedModule Find(ulong addr)
+        {
+            // Find the last segment starting at or before addr
+            int lo = 0, hi = _segments.Length - 1, last = -1;
+            while (lo <= hi)
+            {
+                int mid = lo + (hi - lo) / 2;
+                if (_segments[mid].Start <= addr)
+                {
+                    last = mid;
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid - 1;
+                }
+            }
+            return last >= 0 && _segments[last].End > addr ? _segments[last].Module : null;
+        }
+    }
+}
@@ -0,0 +1,293 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Globalization;
+using System.Text;
+
+namespace Microsoft.MIDebugEngine
+{
+    internal enum PrimitiveKind
+    {
+        None,
+        Signed,
+        Unsigned,
+        Char,           // plain char, whose signedness depends on the target
+        SignedChar,
+        UnsignedChar,
+        Bool,
+        Float
+    }
+
+    /// <summary>
+    /// Formats values of C/C++ primitive types decoded from target memory the way gdb prints them, so that an array of
+    /// primitives can be displayed from one memory read instead of a variable object per element.
+    /// </summary>
+    internal static class PrimitiveFormatter
+    {
+        /// <summary>
+        /// Classifies a type name as reported by the debugger, ignoring cv-qualifiers. Returns None for anything that
+        /// isn't a primitive type this class can format.
+        /// </summary>
+        public static PrimitiveKind GetKind(string typeName)
+        {
+            string name = typeName.Trim();
+            while (true)
+            {
+                if (name.StartsWith("const ", StringComparison.Ordinal))
+                {
+                    name = name.Substring(6).TrimStart();
+                }
+                else if (name.StartsWith("volatile ", StringComparison.Ordinal))
+                {
+                    name = name.Substring(9).TrimStart();
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            switch (name)
+            {
+                case "short":
+                case "short int":
+                case "int":
+                case "long":
+                case "long int":
+                case "long long":
+                case "long long int":
+                case "int16_t":
+                case "int32_t":
+                case "int64_t":
+                case "ssize_t":
+                case "ptrdiff_t":
+                case "intptr_t":
+                    return PrimitiveKind.Signed;
+                case "unsigned short":
+                case "short unsigned int":
+                case "unsigned int":
+                case "unsigned":
+                case "unsigned long":
+                case "long unsigned int":
+                case "unsigned long long":
+                case "long long unsigned int":
+                case "uint16_t":
+                case "uint32_t":
+                case "uint64_t":
+                case "size_t":
+                case "uintptr_t":
+                    return PrimitiveKind.Unsigned;
+                case "char":
+                    return PrimitiveKind.Char;
+                case "signed char":
+                case "int8_t":
+                    return PrimitiveKind.SignedChar;
+                case "unsigned char":
+                case "uint8_t":
+                    return PrimitiveKind.UnsignedChar;
+                case "bool":
+                case "_Bool":
+                    return PrimitiveKind.Bool;
+                case "float":
+                case "double":
+                    return PrimitiveKind.Float;
+                default:
+                    return PrimitiveKind.None;
+            }
+        }
+
+        /// <summary>
+        /// Checks that an element size reported by the debugger is one the kind can be decoded from.
+        /// </summary>
+        public static bool IsValidSize(PrimitiveKind kind, uint size)
+        {
+            switch (kind)
+            {
+                case PrimitiveKind.Signed:
+                case PrimitiveKind.Unsigned:
+                    return size == 1 || size == 2 || size == 4 || size == 8;
+                case PrimitiveKind.Char:
+                case PrimitiveKind.SignedChar:
+                case PrimitiveKind.UnsignedChar:
+                case PrimitiveKind.Bool:
+                    return size == 1;
+                case PrimitiveKind.Float:
+                    return size == 4 || size == 8;
+                default:
+                    return false;
+            }
+        }
+
+        /// <summary>
+        /// Formats <paramref name="count"/> consecutive little-endian elements of <paramref name="size"/> bytes each.
+        /// </summary>
+        /// <param name="radix">Output radix of the debugger, 10 or 16</param>
+        /// <param name="format">Format set with -var-set-format, or null for the natural format</param>
+        /// <returns>The values, or null if the debugger would have to format them (e.g. a format applied to floating point values)</returns>
+        public static string[] Format(byte[] bytes, int count, PrimitiveKind kind, uint size, uint radix, string format)
+        {
+            if (kind == PrimitiveKind.Char || !IsValidSize(kind, size) || bytes.Length < count * size)
+            {
+                return null;
+            }
+            if (format == "natural")
+            {
+                format = null;  // the natural format follows the output radix, like no format at all
+            }
+            if (format != null && (kind == PrimitiveKind.Float || !IsIntegerFormat(format)))
+            {
+                return null;
+            }
+
+            string[] values = new string[count];
+            int width = (int)size;
+            bool isSigned = kind == PrimitiveKind.Signed || kind == PrimitiveKind.SignedChar;
+            for (int i = 0; i < count; i++)
+            {
+                ulong raw = ReadRaw(bytes, i * width, width);
+                if (format != null)
+                {
+                    values[i] = FormatInteger(raw, width, isSigned, format);
+                }
+                else
+                {
+                    switch (kind)
+                    {
+                        case PrimitiveKind.Bool:
+                            values[i] = raw == 0 ? "false" : raw == 1 ? "true" : raw.ToString(CultureInfo.InvariantCulture);
+                            break;
+                        case PrimitiveKind.Float:
+                            values[i] = width == 4 ? FormatFloat(raw) : FormatDouble(raw);
+                            break;
+                        case PrimitiveKind.SignedChar:
+                        case PrimitiveKind.UnsignedChar:
+                            values[i] = FormatInteger(raw, width, isSigned, radix == 16 ? "hexadecimal" : "decimal") + " " + CharLiteral((byte)raw);
+                            break;
+                        default:
+                            values[i] = FormatInteger(raw, width, isSigned, radix == 16 ? "hexadecimal" : "decimal");
+                            break;
+                    }
+                }
+            }
+            return values;
+        }
+
+        private static bool IsIntegerFormat(string format)
+        {
+            return format == "hexadecimal" || format == "zero-hexadecimal" || format == "octal" || format == "decimal" || format == "binary";
+        }
+
+        private static ulong ReadRaw(byte[] bytes, int offset, int width)
+        {
+            ulong raw = 0;
+            for (int b = width - 1; b >= 0; b--)
+            {
+                raw = (raw << 8) | bytes[offset + b];
+            }
+            return raw;
+        }
+
+        private static string FormatInteger(ulong raw, int width, bool isSigned, string format)
+        {
+            int bits = width * 8;
+            switch (format)
+            {
+                case "hexadecimal":
+                    return "0x" + raw.ToString("x", CultureInfo.InvariantCulture);
+                case "zero-hexadecimal":
+                    return "0x" + raw.ToString("x" + (width * 2).ToString(CultureInfo.InvariantCulture), CultureInfo.InvariantCulture);
+                case "octal":
+                    return raw == 0 ? "0" : "0" + ToBase(raw, 8);
+                case "binary":
+                    return ToBase(raw, 2);
+                default:
+                    if (isSigned && bits < 64 && (raw & (1UL << (bits - 1))) != 0)
+                    {
+                        return ((long)(raw | (ulong.MaxValue << bits))).ToString(CultureInfo.InvariantCulture);
+                    }
+                    return isSigned ? ((long)raw).ToString(CultureInfo.InvariantCulture) : raw.ToString(CultureInfo.InvariantCulture);
+            }
+        }
+
+        private static string ToBase(ulong value, int radix)
+        {
+            if (value == 0)
+            {
+                return "0";
+            }
+            char[] digits = new char[64];
+            int pos = digits.Length;
+            while (value != 0)
+            {
+                digits[--pos] = (char)('0' + (int)(value % (ulong)radix));
+                value /= (ulong)radix;
+            }
+            return new string(digits, pos, digits.Length - pos);
+        }
+
+        // gdb prints floating point values with %g and enough digits to round trip: 9 for float, 17 for double
+        private static string FormatFloat(ulong raw)
+        {
+            uint bits = (uint)raw;
+            float value = BitConverter.ToSingle(BitConverter.GetBytes(bits), 0);
+            if (float.IsNaN(value))
+            {
+                return ((bits & 0x80000000) != 0 ? "-" : "") + "nan(0x" + (bits & 0x7fffff).ToString("x", CultureInfo.InvariantCulture) + ")";
+            }
+            return FormatReal(value, (bits & 0x80000000) != 0, "G9");
+        }
+
+        private static string FormatDouble(ulong raw)
+        {
+            double value = BitConverter.Int64BitsToDouble((long)raw);
+            if (double.IsNaN(value))
+            {
+                return ((raw & 0x8000000000000000) != 0 ? "-" : "") + "nan(0x" + (raw & 0xfffffffffffff).ToString("x", CultureInfo.InvariantCulture) + ")";
+            }
+            return FormatReal(value, (raw & 0x8000000000000000) != 0, "G17");
+        }
+
+        private static string FormatReal(double value, bool isNegative, string format)
+        {
+            if (double.IsInfinity(value))
+            {
+                return isNegative ? "-inf" : "inf";
+            }
+            if (value == 0)
+            {
+                return isNegative ? "-0" : "0";
+            }
+            return value.ToString(format, CultureInfo.InvariantCulture).Replace('E', 'e');
+        }
+
+        private static string CharLiteral(byte c)
+        {
+            StringBuilder literal = new StringBuilder("'", 7);
+            switch (c)
+            {
+                case 7: literal.Append("\\a"); break;
+                case 8: literal.Append("\\b"); break;
+                case 9: literal.Append("\\t"); break;
+                case 10: literal.Append("\\n"); break;
+                case 11: literal.Append("\\v"); break;
+                case 12: literal.Append("\\f"); break;
+                case 13: literal.Append("\\r"); break;
+                case 27: literal.Append("\\033"); break;
+                case (byte)'\'': literal.Append("\\'"); break;
+                case (byte)'\\': literal.Append("\\\\"); break;
+                default:
+                    if (c >= 0x20 && c < 0x7f)
+                    {
+                        literal.Append((char)c);
+                    }
+                    else
+                    {
+                        literal.Append('\\').Append(Convert.ToString(c, 8).PadLeft(3, '0'));
+                    }
+                    break;
+            }
+            return literal.Append('\'').ToString();
+        }
+    }
+}
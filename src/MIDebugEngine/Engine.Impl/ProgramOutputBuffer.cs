@@ -0,0 +1,281 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using MICore;
+using Microsoft.DebugEngineHost;
+using System;
+using System.Globalization;
+using System.IO;
+using System.Text;
+using System.Threading;
+using Logger = MICore.Logger;
+
+namespace Microsoft.MIDebugEngine
+{
+    /// <summary>
+    /// Forwards program and debugger output to the IDE in batches from a background thread, so the thread reading the MI
+    /// debugger's output doesn't wait for the IDE. If a limit of lines per second is configured, program output arriving
+    /// faster than that, or while too much output is already waiting to be sent, is dropped and replaced by a count of
+    /// the dropped lines. Debugger output is never dropped. Without a limit nothing is dropped: once too much output is
+    /// waiting, writing waits for the IDE instead.
+    /// </summary>
+    internal sealed class ProgramOutputBuffer
+    {
+        private const int FlushIntervalMs = 50;
+        private const int ChunkSize = 32 * 1024;                    // wake the writer once this many characters are waiting
+        private const int MaxBufferedChars = 4 * 1024 * 1024;       // drop or wait beyond this until the IDE catches up
+        private const int RateWindowMs = 1000;
+        private const int FileBufferSize = 64 * 1024;
+
+        private readonly Action<string> _send;
+        private readonly int _maxLinesPerSecond;
+        private readonly Logger _logger;
+        private readonly int _flushIntervalMs;
+        private readonly Func<int> _tickCount;
+
+        // Guards the buffered output, the rate counters and the log file
+        private readonly object _lock = new object();
+        private StringBuilder _buffer = new StringBuilder();
+        private StreamWriter _logFile;
+        private int _windowStart;
+        private int _windowLines;
+        private int _droppedLines;
+
+        // Held while output is sent, so chunks reach the IDE in order
+        private readonly object _sendLock = new object();
+        private readonly AutoResetEvent _wakeWriter = new AutoResetEvent(false);
+        private readonly Thread _writerThread;
+        private volatile bool _closed;
+
+        /// <param name="send">Sends output to the IDE</param>
+        /// <param name="maxLinesPerSecond">Lines sent per second before the rest are dropped, or 0 for no limit</param>
+        /// <param name="logFile">File which receives all the output, including dropped lines, or null</param>
+        public ProgramOutputBuffer(Action<string> send, int maxLinesPerSecond, string logFile, Logger logger)
+            : this(send, maxLinesPerSecond, logFile, logger, FlushIntervalMs, () => Environment.TickCount)
+        {
+        }
+
+        /// <param name="flushIntervalMs">How often the writer thread sends what's waiting, or Timeout.Infinite to only
+        /// send full chunks until flushed</param>
+        /// <param name="tickCount">Clock of the rate window, in milliseconds</param>
+        internal ProgramOutputBuffer(Action<string> send, int maxLinesPerSecond, string logFile, Logger logger, int flushIntervalMs, Func<int> tickCount)
+        {
+            _send = send;
+            _maxLinesPerSecond = maxLinesPerSecond;
+            _logger = logger;
+            _flushIntervalMs = flushIntervalMs;
+            _tickCount = tickCount;
+            _windowStart = _tickCount();
+
+            if (!string.IsNullOrEmpty(logFile))
+            {
+                try
+                {
+                    var stream = new FileStream(logFile, FileMode.Create, FileAccess.Write, FileShare.Read);
+                    _logFile = new StreamWriter(stream, new UTF8Encoding(encoderShouldEmitUTF8Identifier: false), FileBufferSize);
+                }
+                catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+                {
+                    _buffer.Append(string.Format(CultureInfo.CurrentCulture, ResourceStrings.ProgramOutputLogFileError, logFile, e.Message)).Append('\n');
+                }
+            }
+
+            _writerThread = new Thread(WriterLoop);
+            _writerThread.Name = "MIEngine program output";
+            _writerThread.IsBackground = true;
+            _writerThread.Start();
+        }
+
+        /// <summary>
+        /// Queues output to be sent. Only waits for the IDE if there is no limit and too much output is waiting.
+        /// </summary>
+        /// <param name="isProgramOutput">True for the program's own output, which is subject to the limit. False for
+        /// output of the debugger, e.g. console messages and logpoints.</param>
+        public void Write(string output, bool isProgramOutput)
+        {
+            if (_closed)
+            {
+                lock (_sendLock)
+                {
+                    _send(output);
+                }
+                return;
+            }
+
+            int lines = CountLines(output);
+            bool wake;
+            bool full;
+            lock (_lock)
+            {
+                WriteLogFile(output);
+                RollRateWindow();
+
+                if (isProgramOutput && _maxLinesPerSecond > 0)
+                {
+                    if (_windowLines + lines > _maxLinesPerSecond || _buffer.Length + output.Length > MaxBufferedChars)
+                    {
+                        _droppedLines += lines;
+                        return;
+                    }
+                    _windowLines += lines;
+                }
+
+                _buffer.Append(output);
+                wake = _buffer.Length >= ChunkSize;
+                full = _buffer.Length > MaxBufferedChars;
+            }
+
+            if (full)
+            {
+                // Nothing is dropped without a limit, so wait for the IDE to catch up
+                Flush();
+            }
+            else if (wake)
+            {
+                _wakeWriter.Set();
+            }
+        }
+
+        /// <summary>
+        /// Sends everything queued so far, including the count of lines dropped. Called before the IDE is told the
+        /// process stopped or exited so that output printed before then shows up first.
+        /// </summary>
+        public void Flush()
+        {
+            lock (_sendLock)
+            {
+                SendPending(reportDropped: true);
+            }
+        }
+
+        /// <summary>
+        /// Sends everything queued, stops the writer thread and closes the log file. Output written afterwards is sent
+        /// immediately.
+        /// </summary>
+        public void Close()
+        {
+            if (_closed)
+            {
+                return;
+            }
+            _closed = true;
+
+            _wakeWriter.Set();
+            if (Thread.CurrentThread != _writerThread)
+            {
+                _writerThread.Join();
+            }
+
+            lock (_sendLock)
+            {
+                SendPending(reportDropped: true);
+                lock (_lock)
+                {
+                    _logFile?.Dispose();
+                    _logFile = null;
+                }
+            }
+        }
+
+        private void WriterLoop()
+        {
+            while (!_closed)
+            {
+                _wakeWriter.WaitOne(_flushIntervalMs);
+                try
+                {
+                    lock (_sendLock)
+                    {
+                        SendPending(reportDropped: false);
+                    }
+                }
+                catch (Exception e) when (ExceptionHelper.BeforeCatch(e, _logger, reportOnlyCorrupting: true))
+                {
+                    // The IDE can't be sent output, e.g. because the session is going away. Keep going until closed.
+                }
+            }
+        }
+
+        // Must be called with _sendLock held
+        private void SendPending(bool reportDropped)
+        {
+            string chunk = null;
+            lock (_lock)
+            {
+                if (reportDropped)
+                {
+                    AppendDroppedLines();
+                }
+                else
+                {
+                    RollRateWindow();
+                }
+
+                if (_buffer.Length != 0)
+                {
+                    chunk = _buffer.ToString();
+                    // Start over rather than Clear() so a burst doesn't pin a large buffer
+                    _buffer = new StringBuilder(Math.Min(chunk.Length, ChunkSize));
+                }
+                _logFile?.Flush();
+            }
+
+            if (chunk != null)
+            {
+                _send(chunk);
+            }
+        }
+
+        // Must be called with _lock held
+        private void WriteLogFile(string output)
+        {
+            if (_logFile == null)
+            {
+                return;
+            }
+            try
+            {
+                _logFile.Write(output);
+            }
+            catch (IOException e)
+            {
+                // e.g. the disk is full. Stop writing the file rather than failing to read the debugger's output.
+                _logger.WriteLine(LogLevel.Error, "Failed to write program output log: {0}", e.Message);
+                _logFile.Dispose();
+                _logFile = null;
+            }
+        }
+
+        // Must be called with _lock held
+        private void RollRateWindow()
+        {
+            int now = _tickCount();
+            if (unchecked(now - _windowStart) >= RateWindowMs)
+            {
+                AppendDroppedLines();
+                _windowStart = now;
+                _windowLines = 0;
+            }
+        }
+
+        // Must be called with _lock held
+        private void AppendDroppedLines()
+        {
+            if (_droppedLines != 0)
+            {
+                _buffer.Append(string.Format(CultureInfo.CurrentCulture, ResourceStrings.ProgramOutputDropped, _droppedLines)).Append('\n');
+                _droppedLines = 0;
+            }
+        }
+
+        private static int CountLines(string output)
+        {
+            int lines = 0;
+            for (int i = output.IndexOf('\n'); i >= 0; i = output.IndexOf('\n', i + 1))
+            {
+                lines++;
+            }
+            return Math.Max(lines, 1);
+        }
+    }
+}
@@ -0,0 +1,188 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using MICore;
+using System.Collections.Generic;
+using System.IO;
+
+namespace Microsoft.MIDebugEngine
+{
+    /// <summary>
+    /// Maps source file names between the editor and the compiled binary using the source file map. The map's paths are
+    /// indexed in a prefix tree per direction, so a file name is matched in a single pass over its characters instead of
+    /// a StartsWith against every entry. As before, the entry that comes first in the source file map wins when several
+    /// match.
+    /// </summary>
+    internal sealed class SourceFileMapper
+    {
+        private sealed class PrefixTree
+        {
+            private sealed class Node
+            {
+                public Dictionary<char, Node> Children;
+                public int EntryIndex = -1;     // first entry of the source file map whose path ends at this node
+            }
+
+            private readonly Node _root = new Node();
+            private readonly bool _ignoreCase;
+
+            public PrefixTree(bool ignoreCase)
+            {
+                _ignoreCase = ignoreCase;
+            }
+
+            public void Add(string path, int entryIndex)
+            {
+                Node node = _root;
+                foreach (char c in path)
+                {
+                    char key = Fold(c);
+                    if (node.Children == null)
+                    {
+                        node.Children = new Dictionary<char, Node>();
+                    }
+                    if (!node.Children.TryGetValue(key, out Node child))
+                    {
+                        child = new Node();
+                        node.Children.Add(key, child);
+                    }
+                    node = child;
+                }
+                if (node.EntryIndex < 0)
+                {
+                    node.EntryIndex = entryIndex;
+                }
+            }
+
+            /// <summary>
+            /// Finds the first entry whose path is a prefix of <paramref name="path"/> ending at a directory boundary.
+            /// </summary>
+            /// <returns>The entry's index, or -1</returns>
+            public int Match(string path)
+            {
+                int match = -1;
+                Node node = _root;
+                for (int i = 0; ; i++)
+                {
+                    // The match must cover the whole name, or break it at a '\' or '/' char
+                    if (node.EntryIndex >= 0 && (match < 0 || node.EntryIndex < match)
+                        && (i == path.Length || IsDirectorySeparator(path[i]) || (i > 0 && IsDirectorySeparator(path[i - 1]))))
+                    {
+                        match = node.EntryIndex;
+                    }
+                    if (i == path.Length || node.Children == null || !node.Children.TryGetValue(Fold(path[i]), out node))
+                    {
+                        return match;
+                    }
+                }
+            }
+
+            private char Fold(char c)
+            {
+                return _ignoreCase ? char.ToUpperInvariant(c) : c;
+            }
+        }
+
+        private static readonly char[] s_directorySeparators = new char[] { Path.DirectorySeparatorChar, Path.AltDirectorySeparatorChar };
+
+        private readonly IReadOnlyList<SourceMapEntry> _sourceMap;
+        private readonly PrefixTree _editorPaths;
+        private readonly PrefixTree _compileTimePaths;
+
+        /// <param name="sourceMap">The source file map, in priority order</param>
+        /// <param name="editorPathsIgnoreCase">True if editor paths are case insensitive</param>
+        /// <param name="compileTimePathsIgnoreCase">True if compile time paths are case insensitive</param>
+        public SourceFileMapper(IReadOnlyList<SourceMapEntry> sourceMap, bool editorPathsIgnoreCase, bool compileTimePathsIgnoreCase)
+        {
+            _sourceMap = sourceMap;
+            _editorPaths = new PrefixTree(editorPathsIgnoreCase);
+            _compileTimePaths = new PrefixTree(compileTimePathsIgnoreCase);
+
+            for (int i = 0; i < sourceMap.Count; i++)
+            {
+                SourceMapEntry e = sourceMap[i];
+                if (e.UseForBreakpoints)
+                {
+                    _editorPaths.Add(e.EditorPath, i);
+                }
+                // don't try to map back if path has an empty compiler src tree
+                if (!string.IsNullOrEmpty(e.CompileTimePath))
+                {
+                    _compileTimePaths.Add(e.CompileTimePath, i);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Maps a file name in the editor to the name the compiler used, in Unix notation.
+        /// </summary>
+        /// <returns>false if no entry applies, in which case <paramref name="compilerSrc"/> is <paramref name="currentSrc"/></returns>
+        public bool MapCurrentToCompileTime(string currentSrc, out string compilerSrc)
+        {
+            int index = _editorPaths.Match(currentSrc);
+            if (index < 0)
+            {
+                compilerSrc = currentSrc;
+                return false;
+            }
+
+            SourceMapEntry e = _sourceMap[index];
+            if (currentSrc.Length == e.EditorPath.Length) // matched the whole string
+            {
+                compilerSrc = e.CompileTimePath;
+                return true;
+            }
+
+            compilerSrc = Path.Combine(e.CompileTimePath, GetRelativePath(currentSrc, e.EditorPath.Length));    // map to the compiled location
+            if (compilerSrc.IndexOf('\\') != -1)
+            {
+                compilerSrc = PlatformUtilities.WindowsPathToUnixPath(compilerSrc); // use Unix notation for the compiled path
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Maps a file name the compiler used, already converted to the host's notation, to the name in the editor.
+        /// </summary>
+        /// <returns>false if no entry applies</returns>
+        public bool MapCompileTimeToCurrent(string hostOSCompilerSrc, out string currentName)
+        {
+            currentName = null;
+            int index = _compileTimePaths.Match(hostOSCompilerSrc);
+            if (index < 0)
+            {
+                return false;
+            }
+
+            SourceMapEntry e = _sourceMap[index];
+            if (hostOSCompilerSrc.Length == e.CompileTimePath.Length) // matched the whole string
+            {
+                char last = hostOSCompilerSrc[hostOSCompilerSrc.Length - 1];
+                if (last == Path.DirectorySeparatorChar || last == Path.AltDirectorySeparatorChar)
+                {
+                    return false;   // directory matched, use default.
+                }
+                currentName = e.EditorPath;  // Is a file
+                return true;
+            }
+
+            currentName = Path.Combine(e.EditorPath, GetRelativePath(hostOSCompilerSrc, e.CompileTimePath.Length));    // map to the compiled location
+            return true;
+        }
+
+        private static string GetRelativePath(string path, int prefixLength)
+        {
+            string file = path.Substring(prefixLength);
+            if (IsDirectorySeparator(file[0]))
+            {
+                file = file.Trim(s_directorySeparators);   // Trim the directory separator(s)
+            }
+            return file;
+        }
+
+        private static bool IsDirectorySeparator(char c)
+        {
+            return c == Path.DirectorySeparatorChar || c == Path.AltDirectorySeparatorChar;
+        }
+    }
+}
@@ -8,49 +8,158 @@ using System.Text;
 using System.Threading.Tasks;
 using System.Diagnostics;
 using MICore;
+using Microsoft.DebugEngineHost;
 
 namespace Microsoft.MIDebugEngine
 {
-    public class SourceLineMap : Dictionary<ulong, SourceLine>
+    /// <summary>
+    /// Line table of a source file as reported by -symbol-list-lines. Addresses and lines are kept in parallel arrays
+    /// sorted by address, with a second index sorted by line, so lookups in either direction are a binary search.
+    /// </summary>
+    internal sealed class SourceLineMap
     {
-        public SourceLineMap(int capacity)
-            : base(capacity)
-        { }
+        public static readonly SourceLineMap Empty = new SourceLineMap(new ulong[0], new uint[0]);
 
-        public void Add(ulong addr, uint line)
+        private readonly ulong[] _addresses;    // sorted, without duplicates
+        private readonly uint[] _lines;         // line of each address, 0 marks the end of a function
+        private readonly int[] _functions;      // number of end of function markers before each address
+        private readonly int[] _byLine;         // indices into _addresses sorted by line, then by address
+
+        /// <param name="addresses">Addresses in the order the debugger listed them</param>
+        /// <param name="lines">Line of each address</param>
+        public SourceLineMap(ulong[] addresses, uint[] lines)
         {
-            base.Add(addr, new SourceLine(line, addr));
+            // Sort by address. Ties keep the listed order so the first line reported for an address is found first.
+            int[] order = new int[addresses.Length];
+            for (int i = 0; i < order.Length; i++)
+            {
+                order[i] = i;
+            }
+            Array.Sort(order, (a, b) =>
+            {
+                int c = addresses[a].CompareTo(addresses[b]);
+                return c != 0 ? c : a.CompareTo(b);
+            });
+
+            List<ulong> sortedAddresses = new List<ulong>(addresses.Length);
+            List<uint> sortedLines = new List<uint>(addresses.Length);
+            foreach (int i in order)
+            {
+                int last = sortedAddresses.Count - 1;
+                if (last >= 0 && sortedAddresses[last] == addresses[i])
+                {
+                    // It is actually fairly common for an address to map to more than one line. For instance,
+                    // in debug builds destructors can have an entry to line 0 as well as one to the correct line.
+                    // Release builds with inlining will hit this very often.
+                    // Unforunately, without more context, it is impossible to know which line is the "right" line.
+                    // For the inline case, any line will be acceptable. For the destructor case, we should prefer
+                    // a non-zero line.
+                    if (sortedLines[last] == 0)
+                    {
+                        sortedLines[last] = lines[i];
+                    }
+                }
+                else
+                {
+                    sortedAddresses.Add(addresses[i]);
+                    sortedLines.Add(lines[i]);
+                }
+            }
+            _addresses = sortedAddresses.ToArray();
+            _lines = sortedLines.ToArray();
+
+            _functions = new int[_addresses.Length];
+            int function = 0;
+            for (int i = 0; i < _lines.Length; i++)
+            {
+                _functions[i] = function;
+                if (_lines[i] == 0)
+                {
+                    function++;
+                }
+            }
+
+            _byLine = new int[_addresses.Length];
+            for (int i = 0; i < _byLine.Length; i++)
+            {
+                _byLine[i] = i;
+            }
+            Array.Sort(_byLine, (a, b) =>
+            {
+                int c = _lines[a].CompareTo(_lines[b]);
+                return c != 0 ? c : a.CompareTo(b);
+            });
         }
 
-        public void Replace(ulong addr, uint line)
+        public int Count { get { return _addresses.Length; } }
+
+        /// <summary>
+        /// Finds the line which starts at <paramref name="addr"/>.
+        /// </summary>
+        public bool TryGetLine(ulong addr, out uint line)
         {
-            base[addr] = new SourceLine(line, addr);
+            int i = Array.BinarySearch(_addresses, addr);
+            line = i >= 0 ? _lines[i] : 0;
+            return i >= 0;
         }
-    }
-
-    public struct SourceLine
-    {
-        public uint Line { get; private set; }
-        public ulong AddrStart { get; private set; }
 
-        public SourceLine(uint line, ulong addr)
+        /// <summary>
+        /// Returns the first address of <paramref name="line"/> in each function the line has code in.
+        /// </summary>
+        public List<ulong> StartAddressesForLine(uint line)
         {
-            Line = line;
-            AddrStart = addr;
+            // Find the first index for the line
+            int lo = 0, hi = _byLine.Length;
+            while (lo < hi)
+            {
+                int mid = lo + (hi - lo) / 2;
+                if (_lines[_byLine[mid]] < line)
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+
+            List<ulong> addresses = new List<ulong>();
+            int lastFunction = -1;
+            for (int i = lo; i < _byLine.Length && _lines[_byLine[i]] == line; i++)
+            {
+                int index = _byLine[i];
+                if (_functions[index] != lastFunction)
+                {
+                    addresses.Add(_addresses[index]);
+                    lastFunction = _functions[index];
+                }
+            }
+            return addresses;
         }
 
-        public bool EndOfFunction { get { return Line == 0; } }
+        /// <summary>
+        /// Checks if any address of the file is in [<paramref name="start"/>, <paramref name="end"/>).
+        /// </summary>
+        public bool ContainsAddressIn(ulong start, ulong end)
+        {
+            int i = Array.BinarySearch(_addresses, start);
+            if (i < 0)
+            {
+                i = ~i;
+            }
+            return i < _addresses.Length && _addresses[i] < end;
+        }
     }
 
     internal class SourceLineCache
     {
-        private Dictionary<string, SourceLineMap> _mapFileToLinenums;
+        private Dictionary<string, Task<SourceLineMap>> _mapFileToLinenums;
         private DebuggedProcess _process;
 
         public SourceLineCache(DebuggedProcess process)
         {
             _process = process;
-            _mapFileToLinenums = new Dictionary<string, SourceLineMap>();
+            _mapFileToLinenums = new Dictionary<string, Task<SourceLineMap>>();
         }
 
         public void Clear()
@@ -61,35 +170,71 @@ namespace Microsoft.MIDebugEngine
             }
         }
 
+        /// <summary>
+        /// Gets the line table of a file. Files are only queried once, concurrent requests for the same file share the
+        /// query, and a file without line information gets an empty table until symbols are loaded.
+        /// </summary>
         internal async Task<SourceLineMap> GetLinesForFile(string file)
         {
-            string fileKey = file;
+            Task<SourceLineMap> task;
+            TaskCompletionSource<SourceLineMap> source = null;
             lock (_mapFileToLinenums)
             {
-                if (_mapFileToLinenums.ContainsKey(fileKey))
+                if (!_mapFileToLinenums.TryGetValue(file, out task))
                 {
-                    return _mapFileToLinenums[fileKey];
+                    source = new TaskCompletionSource<SourceLineMap>(TaskCreationOptions.RunContinuationsAsynchronously);
+                    task = source.Task;
+                    _mapFileToLinenums.Add(file, task);
                 }
             }
-            SourceLineMap linesMap = null;
-            linesMap = await LinesForFile(fileKey);
-            lock (_mapFileToLinenums)
+
+            if (source != null)
             {
-                if (_mapFileToLinenums.ContainsKey(fileKey))
+                try
                 {
-                    return _mapFileToLinenums[fileKey];
+                    source.SetResult(await LinesForFile(file) ?? SourceLineMap.Empty);
                 }
-                if (linesMap != null)
+                catch (Exception e)
                 {
-                    _mapFileToLinenums.Add(fileKey, linesMap);
+                    lock (_mapFileToLinenums)
+                    {
+                        if (_mapFileToLinenums.TryGetValue(file, out Task<SourceLineMap> current) && current == task)
+                        {
+                            _mapFileToLinenums.Remove(file);    // don't remember failures
+                        }
+                    }
+                    source.SetException(e);
                 }
-                else
+            }
+            return await task;
+        }
+
+        /// <summary>
+        /// Starts loading the line table of a file in the background if it isn't already cached.
+        /// </summary>
+        internal void Prefetch(string file)
+        {
+            lock (_mapFileToLinenums)
+            {
+                if (_mapFileToLinenums.ContainsKey(file))
                 {
-                    _mapFileToLinenums.Add(fileKey, new SourceLineMap(0));    // empty list to prevent requerying. Release this list on dynamic library loading
+                    return;
                 }
-                return _mapFileToLinenums[fileKey];
             }
+
+            Task.Run(async () =>
+            {
+                try
+                {
+                    await GetLinesForFile(file);
+                }
+                catch (Exception e)
+                {
+                    _process.Logger.WriteLine(LogLevel.Verbose, "Failed to prefetch lines for {0}: {1}", file, e.Message);
+                }
+            });
         }
+
         private async Task<SourceLineMap> LinesForFile(string file)
         {
             string cmd = "-symbol-list-lines " + _process.EnsureProperPathSeparators(file);
@@ -101,41 +246,42 @@ namespace Microsoft.MIDebugEngine
             }
 
             ValueListValue lines = results.Find<ValueListValue>("lines");
-            SourceLineMap linesMap = new SourceLineMap(lines.Content.Length);
+            ulong[] addresses = new ulong[lines.Content.Length];
+            uint[] linenums = new uint[lines.Content.Length];
             for (int i = 0; i < lines.Content.Length; ++i)
             {
-                ulong addr = lines.Content[i].FindAddr("pc");
-                uint line = lines.Content[i].FindUint("line");
-
-                if (linesMap.ContainsKey(addr))
-                {
-                    // It is actually fairly common for an address to map to more than one line. For instance,
-                    // in debug builds destructors can have an entry to line 0 as well as one to the correct line.
-                    // Release builds with inlining will hit this very often.
-                    // Unforunately, without more context, it is impossible to know which line is the "right" line.
-                    // For the inline case, any line will be acceptable. For the destructor case, we should prefer
-                    // a non-zero line.
-                    if (linesMap[addr].Line == 0)
-                    {
-                        linesMap.Replace(addr, line);
-                    }
-                }
-                else
-                {
-                    linesMap.Add(addr, line);
-                }
+                addresses[i] = lines.Content[i].FindAddr("pc");
+                linenums[i] = lines.Content[i].FindUint("line");
             }
-            return linesMap;
+            return new SourceLineMap(addresses, linenums);
         }
 
+        /// <summary>
+        /// Drops the files without line information so they are queried again, since new symbols may cover them.
+        /// </summary>
         internal void OnLibraryLoad()
+        {
+            RemoveWhere((lines) => lines.Count == 0);
+        }
+
+        /// <summary>
+        /// Drops the files with code in an unloaded module, since their addresses are no longer valid.
+        /// </summary>
+        internal void OnModuleUnload(DebuggedModule module)
+        {
+            List<KeyValuePair<ulong, ulong>> ranges = module.AddressRanges().ToList();
+            RemoveWhere((lines) => ranges.Any((r) => lines.ContainsAddressIn(r.Key, r.Value)));
+        }
+
+        private void RemoveWhere(Func<SourceLineMap, bool> predicate)
         {
             lock (_mapFileToLinenums)
             {
                 List<string> toDelete = new List<string>();
                 foreach (var l in _mapFileToLinenums)
                 {
-                    if (l.Value.Count == 0)
+                    // Queries still in progress are left alone
+                    if (l.Value.Status == TaskStatus.RanToCompletion && predicate(l.Value.Result))
                     {
                         toDelete.Add(l.Key);
                     }
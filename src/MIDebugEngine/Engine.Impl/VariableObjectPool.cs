@@ -0,0 +1,244 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using MICore;
+
+namespace Microsoft.MIDebugEngine
+{
+    /// <summary>
+    /// Keeps the variable objects of evaluated expressions across stops, so evaluating the same expression in the same
+    /// frame again can refresh the existing object with -var-update instead of creating a new one. Objects which
+    /// aren't reused during the break after the one they were released in are expired, and should then be deleted.
+    /// All the pooled objects can be refreshed at once with "-var-update *", see <see cref="Update"/>.
+    /// A variable object created with "-var-create - *" stays bound to the frame it was created in, so keys use the
+    /// frame's identity rather than its level: after a step into a recursive call the same level is a different frame,
+    /// and the caller's objects, such as its locals, are still valid one level up.
+    /// </summary>
+    internal sealed class VariableObjectPool
+    {
+        internal struct Key : IEquatable<Key>
+        {
+            public readonly string Expression;
+            public readonly int ThreadId;
+            public readonly string Frame;   // identifies the call the expression is evaluated in, see DebuggedProcess.GetFrameIdentity
+            public readonly uint Flags;
+            public readonly uint Radix;
+
+            public Key(string expression, int threadId, string frame, uint flags, uint radix)
+            {
+                Expression = expression;
+                ThreadId = threadId;
+                Frame = frame;
+                Flags = flags;
+                Radix = radix;
+            }
+
+            public bool Equals(Key other)
+            {
+                return Expression == other.Expression && ThreadId == other.ThreadId && Frame == other.Frame
+                    && Flags == other.Flags && Radix == other.Radix;
+            }
+
+            public override bool Equals(object obj)
+            {
+                return obj is Key && Equals((Key)obj);
+            }
+
+            public override int GetHashCode()
+            {
+                unchecked
+                {
+                    int hash = Expression != null ? Expression.GetHashCode() : 0;
+                    hash = hash * 31 + ThreadId;
+                    hash = hash * 31 + (Frame != null ? Frame.GetHashCode() : 0);
+                    hash = hash * 31 + (int)Flags;
+                    return hash * 31 + (int)Radix;
+                }
+            }
+        }
+
+        /// <summary>
+        /// What was known about a variable object when it was released.
+        /// </summary>
+        internal sealed class Entry
+        {
+            public string Name;
+            public string TypeName;
+            public string Value;
+            public uint CountChildren;
+            public string DisplayHint;
+            public bool IsReadOnly;
+            public bool AttributesFetched;
+            public bool Updated;    // refreshed by Update during the current break
+            internal int Generation;
+        }
+
+        private readonly Dictionary<Key, Entry> _entries = new Dictionary<Key, Entry>();
+        private int _generation;
+        private int _updatedGeneration;
+
+        public int Count
+        {
+            get
+            {
+                lock (_entries)
+                {
+                    return _entries.Count;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Starts a new break. Objects released before this are expired by the next call to <see cref="Expire"/> unless
+        /// they are taken first.
+        /// </summary>
+        public void OnBreak()
+        {
+            lock (_entries)
+            {
+                _generation++;
+                foreach (Entry entry in _entries.Values)
+                {
+                    entry.Updated = false;
+                }
+            }
+        }
+
+        public int Generation
+        {
+            get
+            {
+                lock (_entries)
+                {
+                    return _generation;
+                }
+            }
+        }
+
+        /// <summary>
+        /// True if there are pooled objects and they haven't been updated since the current break started.
+        /// </summary>
+        public bool NeedsUpdate
+        {
+            get
+            {
+                lock (_entries)
+                {
+                    return _updatedGeneration != _generation && _entries.Count != 0;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Applies the changelist of a "-var-update --all-values *" to the pooled objects, which can then be reused
+        /// without updating them one at a time.
+        /// </summary>
+        /// <param name="changelist">The changelist, or null if the update failed</param>
+        /// <returns>The names of the objects which went out of scope or changed type. They are removed from the pool
+        /// and should be deleted.</returns>
+        public List<string> Update(TupleValue[] changelist)
+        {
+            List<string> removed = new List<string>();
+            lock (_entries)
+            {
+                _updatedGeneration = _generation;
+                if (changelist == null)
+                {
+                    return removed;
+                }
+
+                Dictionary<string, Key> keys = new Dictionary<string, Key>(_entries.Count);
+                foreach (var e in _entries)
+                {
+                    e.Value.Updated = true;
+                    keys[e.Value.Name] = e.Key;
+                }
+
+                foreach (TupleValue change in changelist)
+                {
+                    Key key;
+                    string name = change.TryFindString("name");
+                    if (name == null || !keys.TryGetValue(name, out key))
+                    {
+                        continue;   // a child, or an object which is in use
+                    }
+
+                    Entry entry = _entries[key];
+                    if (change.TryFindString("in_scope") != "true" || change.TryFindString("type_changed") == "true")
+                    {
+                        _entries.Remove(key);
+                        removed.Add(name);
+                        continue;
+                    }
+                    entry.Value = change.TryFindString("value") ?? entry.Value;
+                    uint? numChildren = change.TryFindUint("new_num_children");
+                    if (numChildren.HasValue)
+                    {
+                        entry.CountChildren = numChildren.Value;
+                    }
+                }
+            }
+            return removed;
+        }
+
+        /// <summary>
+        /// Takes the variable object released for <paramref name="key"/>, if there is one.
+        /// </summary>
+        public Entry Take(Key key)
+        {
+            lock (_entries)
+            {
+                Entry entry;
+                if (_entries.TryGetValue(key, out entry))
+                {
+                    _entries.Remove(key);
+                }
+                return entry;
+            }
+        }
+
+        /// <summary>
+        /// Releases a variable object for reuse.
+        /// </summary>
+        /// <returns>The name of a variable object released earlier for the same key, which should be deleted</returns>
+        public string Release(Key key, Entry entry)
+        {
+            lock (_entries)
+            {
+                Entry displaced;
+                _entries.TryGetValue(key, out displaced);
+                entry.Generation = _generation;
+                _entries[key] = entry;
+                return displaced?.Name;
+            }
+        }
+
+        /// <summary>
+        /// Removes the variable objects which were released before the current break and haven't been taken since.
+        /// </summary>
+        /// <returns>The names of the removed variable objects</returns>
+        public List<string> Expire()
+        {
+            List<string> expired = new List<string>();
+            lock (_entries)
+            {
+                List<Key> keys = new List<Key>();
+                foreach (var e in _entries)
+                {
+                    if (e.Value.Generation < _generation)
+                    {
+                        keys.Add(e.Key);
+                        expired.Add(e.Value.Name);
+                    }
+                }
+                foreach (Key key in keys)
+                {
+                    _entries.Remove(key);
+                }
+            }
+            return expired;
+        }
+    }
+}
@@ -8,7 +8,9 @@ using System;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.Globalization;
+using System.Linq;
 using System.Text.RegularExpressions;
+using System.Threading;
 using System.Threading.Tasks;
 
 namespace Microsoft.MIDebugEngine
@@ -336,6 +338,21 @@ namespace Microsoft.MIDebugEngine
             this.PropertyInfoFlags = parent.PropertyInfoFlags;
         }
 
+        //this constructor is private because it should only be used internally to create array elements decoded from memory
+        private VariableInformation(VariableInformation parent, uint index, string typeName, string value)
+            : this(parent._ctx, parent._engine, parent.Client)
+        {
+            Name = '[' + index.ToString(CultureInfo.InvariantCulture) + ']';
+            TypeName = typeName;
+            Value = value;
+            VariableNodeType = NodeType.ArrayElement;
+            IsChild = true;
+            _attribsFetched = true; // no variable object, Assign creates one when needed
+            _format = parent._format;
+            _parent = parent;
+            this.PropertyInfoFlags = parent.PropertyInfoFlags;
+        }
+
         public ThreadContext ThreadContext { get { return _ctx; } }
 
 
@@ -358,6 +375,14 @@ namespace Microsoft.MIDebugEngine
         }
 
         private string _internalName;  // the MI debugger's private name for this value
+        private VariableObjectPool.Key? _poolKey;  // set if the variable object can be reused after this is disposed
+        private uint? _arrayLength;  // number of array elements, CountChildren only counts those listed
+        private ArrayElementCache<VariableInformation> _elements;  // array elements fetched by GetChildrenRange, see Elements
+        private Task _elementLayout;
+        private PrimitiveKind _elementKind;  // kind of the array's elements if they can be decoded from memory, else None
+        private string _elementType;
+        private uint _elementSize;
+        private ulong _elementsAddress;
         private AD7Engine _engine;
         private DebuggedProcess _debuggedProcess;
         private ThreadContext _ctx;
@@ -667,11 +692,30 @@ namespace Microsoft.MIDebugEngine
                         }
                     }
 
-                    Results results = await _engine.DebuggedProcess.MICommandFactory.VarCreate(expression, threadId, frameLevel, dwFlags, ResultClass.None);
+                    VariableObjectPool.Key? poolKey = null;
+                    if (_debuggedProcess.MICommandFactory.Mode == MIMode.Gdb && _format == null && _deferedFormatExpression == null && !canRunClipboardContextCommands)
+                    {
+                        string frame = await _debuggedProcess.GetFrameIdentity(threadId, frameLevel, _ctx.Function);
+                        if (frame != null)
+                        {
+                            poolKey = new VariableObjectPool.Key(expression, threadId, frame, (uint)dwFlags, _debuggedProcess.MICommandFactory.Radix);
+                        }
+                    }
+
+                    bool reused = poolKey.HasValue && await TryReuseVariableObject(poolKey.Value);
+                    Results results = reused ? null : await _engine.DebuggedProcess.MICommandFactory.VarCreate(expression, threadId, frameLevel, dwFlags, ResultClass.None);
 
-                    if (results.ResultClass == ResultClass.done)
+                    if (reused)
+                    {
+                        _poolKey = poolKey;
+                    }
+                    else if (results.ResultClass == ResultClass.done)
                     {
                         _internalName = results.FindString("name");
+                        if (!results.Contains("dynamic"))
+                        {
+                            _poolKey = poolKey;     // pretty printed children can change shape, so those aren't reused
+                        }
                         TypeName = results.TryFindString("type");
                         if (results.Contains("dynamic"))
                         {
@@ -754,6 +798,56 @@ namespace Microsoft.MIDebugEngine
             }
         }
 
+        /// <summary>
+        /// Takes the variable object released for the same expression and frame at an earlier stop, if there is one, and
+        /// refreshes it with -var-update unless the pool already did.
+        /// </summary>
+        /// <returns>False if there was no object to reuse, or it went out of scope or changed type</returns>
+        private async Task<bool> TryReuseVariableObject(VariableObjectPool.Key key)
+        {
+            VariableObjectPool.Entry entry = await _debuggedProcess.TakeVariableObject(key);
+            if (entry == null)
+            {
+                return false;
+            }
+
+            TupleValue change = null;
+            if (!entry.Updated)
+            {
+                Results results = await _debuggedProcess.MICommandFactory.VarUpdate(entry.Name, ResultClass.None);
+                if (results.ResultClass == ResultClass.done)
+                {
+                    change = results.Find<ValueListValue>("changelist").AsArray<TupleValue>().FirstOrDefault((c) => c.TryFindString("name") == entry.Name);
+                }
+                if (results.ResultClass != ResultClass.done || (change != null && (change.TryFindString("in_scope") != "true" || change.TryFindString("type_changed") == "true")))
+                {
+                    lock (_debuggedProcess.VariablesToDelete)
+                    {
+                        _debuggedProcess.VariablesToDelete.Add(entry.Name);
+                    }
+                    return false;
+                }
+            }
+
+            _internalName = entry.Name;
+            TypeName = entry.TypeName;
+            Value = entry.Value;
+            CountChildren = entry.CountChildren;
+            DisplayHint = entry.DisplayHint;
+            _isReadonly = entry.IsReadOnly;
+            _attribsFetched = entry.AttributesFetched;
+            if (change != null)
+            {
+                Value = change.TryFindString("value") ?? Value;
+                uint? numChildren = change.TryFindUint("new_num_children");
+                if (numChildren.HasValue)
+                {
+                    CountChildren = numChildren.Value;
+                }
+            }
+            return true;
+        }
+
         internal async Task Format()
         {
             this.VerifyNotDisposed();
@@ -798,6 +892,187 @@ namespace Microsoft.MIDebugEngine
             }
         }
 
+        /// <summary>
+        /// Number of elements of an array whose elements can be fetched a range at a time with <see cref="GetChildrenRange"/>,
+        /// or zero if this is not such an array.
+        /// </summary>
+        public uint IndexedChildCount
+        {
+            get
+            {
+                if (IsPreformatted || string.IsNullOrEmpty(_internalName) || !IsArrayType())
+                {
+                    return 0;
+                }
+                return _arrayLength ?? CountChildren;
+            }
+        }
+
+        /// <summary>
+        /// Returns the array elements [start, start + count), listing only those elements not already fetched.
+        /// </summary>
+        public VariableInformation[] GetChildrenRange(uint start, uint count)
+        {
+            count = ArrayElementCache<VariableInformation>.ClampCount(start, count, IndexedChildCount);
+            if (count == 0)
+            {
+                return new VariableInformation[0];
+            }
+
+            Task task = Task.Run(() => FetchChildrenRange(start, start + count));
+            task.Wait();
+
+            List<VariableInformation> range = new List<VariableInformation>((int)count);
+            for (uint i = start; i < start + count; i++)
+            {
+                VariableInformation element = ElementAt(i);
+                if (element != null)
+                {
+                    range.Add(element);
+                }
+            }
+            return range.ToArray();
+        }
+
+        private VariableInformation ElementAt(uint index)
+        {
+            if (Children != null && index < Children.Length)
+            {
+                return Children[index];
+            }
+            return _elements?.Get(index);
+        }
+
+        private ArrayElementCache<VariableInformation> Elements
+        {
+            get { return LazyInitializer.EnsureInitialized(ref _elements); }
+        }
+
+        private async Task FetchChildrenRange(uint start, uint end)
+        {
+            this.VerifyNotDisposed();
+
+            // Children listed by EnsureChildren are the first elements
+            if (Children != null)
+            {
+                start = Math.Max(start, Math.Min((uint)Children.Length, end));
+            }
+            if (!Elements.TrimFetched(ref start, ref end))
+            {
+                return;
+            }
+
+            VariableInformation[] elements = await DecodeElements(start, end - start);
+            if (elements == null)
+            {
+                Results results = await _engine.DebuggedProcess.MICommandFactory.VarListChildren(_internalName, PropertyInfoFlags, start, end, ResultClass.None);
+                if (results.ResultClass != ResultClass.done || !results.Contains("children"))
+                {
+                    return;
+                }
+
+                TupleValue[] children = results.Find<ResultListValue>("children").FindAll<TupleValue>("child");
+                elements = new VariableInformation[children.Length];
+                for (int i = 0; i < children.Length; i++)
+                {
+                    elements[i] = new VariableInformation(children[i], this);
+                }
+                if (_format != null)
+                {
+                    await Task.WhenAll(elements.Select(element => element.Format()));
+                }
+            }
+
+            Elements.Add(start, elements);
+        }
+
+        private static readonly Regex s_arrayType = new Regex(@"^(.*\S)\s*\[\d+\]$");
+
+        /// <summary>
+        /// Decodes the elements [start, start + count) of an array of a primitive type from a single memory read, instead of
+        /// listing them as a variable object each. Returns null if the elements can't be decoded this way.
+        /// </summary>
+        private async Task<VariableInformation[]> DecodeElements(uint start, uint count)
+        {
+            Task layout;
+            lock (Elements)
+            {
+                _elementLayout = _elementLayout ?? FetchElementLayout();
+                layout = _elementLayout;
+            }
+            await layout;
+            if (_elementKind == PrimitiveKind.None || count == 0)
+            {
+                return null;
+            }
+
+            byte[] bytes = new byte[(ulong)count * _elementSize];
+            uint bytesRead = await _debuggedProcess.ReadProcessMemory(_elementsAddress + (ulong)start * _elementSize, (uint)bytes.Length, bytes);
+            if (bytesRead != bytes.Length)
+            {
+                // let the debugger report the elements it can't read
+                return null;
+            }
+
+            string[] values = PrimitiveFormatter.Format(bytes, (int)count, _elementKind, _elementSize, _debuggedProcess.MICommandFactory.Radix, _format);
+            if (values == null)
+            {
+                return null;
+            }
+            VariableInformation[] elements = new VariableInformation[count];
+            for (uint i = 0; i < count; i++)
+            {
+                elements[i] = new VariableInformation(this, start + i, _elementType, values[i]);
+            }
+            return elements;
+        }
+
+        private async Task FetchElementLayout()
+        {
+            Match match = s_arrayType.Match(TypeName ?? string.Empty);
+            if (!match.Success || IsPreformatted || _ctx.Level == null || Client == null)
+            {
+                return;
+            }
+            string elementType = match.Groups[1].Value;
+            PrimitiveKind kind = PrimitiveFormatter.GetKind(elementType);
+            if (kind == PrimitiveKind.None || !await _debuggedProcess.IsTargetLittleEndian())
+            {
+                return;
+            }
+
+            MICommandFactory commandFactory = _debuggedProcess.MICommandFactory;
+            int threadId = Client.GetDebuggedThread().Id;
+            uint frameLevel = _ctx.Level.Value;
+            string array = FullName();
+            try
+            {
+                // These are independent, so send them all at once
+                Task<string> address = commandFactory.DataEvaluateExpression("(unsigned long long)&(" + array + ")", threadId, frameLevel);
+                Task<string> size = commandFactory.DataEvaluateExpression("sizeof((" + array + ")[0])", threadId, frameLevel);
+                Task<string> isCharSigned = kind == PrimitiveKind.Char ? commandFactory.DataEvaluateExpression("(char)-1 < 0", threadId, frameLevel) : Task.FromResult<string>(null);
+                await Task.WhenAll(address, size, isCharSigned);
+
+                if (kind == PrimitiveKind.Char)
+                {
+                    kind = isCharSigned.Result == "1" || isCharSigned.Result == "true" ? PrimitiveKind.SignedChar : PrimitiveKind.UnsignedChar;
+                }
+                uint elementSize = MICore.Debugger.ParseUint(size.Result);
+                if (!PrimitiveFormatter.IsValidSize(kind, elementSize))
+                {
+                    return;
+                }
+                _elementsAddress = MICore.Debugger.ParseAddr(address.Result);
+                _elementSize = elementSize;
+                _elementType = elementType;
+                _elementKind = kind;
+            }
+            catch (MIException)
+            {
+                // fall back to listing the elements
+            }
+        }
+
         private Task FetchChildren()
         {
             // Note: I am not sure if it is actually useful to run the evaluation code off of the poll thread (will GDB actually handle other commands at the same time)
@@ -809,8 +1084,24 @@ namespace Microsoft.MIDebugEngine
         {
             this.VerifyNotDisposed();
 
+            if (IsArrayType())
+            {
+                VariableInformation[] elements = await DecodeElements(0, Math.Min(CountChildren, MICommandFactory.MaxListedChildren));
+                if (elements != null)
+                {
+                    _arrayLength = _arrayLength ?? CountChildren;
+                    Children = elements;
+                    CountChildren = (uint)elements.Length;
+                    return;
+                }
+            }
+
             Results results = await _engine.DebuggedProcess.MICommandFactory.VarListChildren(_internalName, PropertyInfoFlags, ResultClass.None);
+            await ProcessChildren(results);
+        }
 
+        private async Task ProcessChildren(Results results)
+        {
             if (results.ResultClass == ResultClass.done)
             {
                 TupleValue[] children = results.Contains("children")
@@ -820,8 +1111,10 @@ namespace Microsoft.MIDebugEngine
                 bool isArray = IsArrayType();
                 if (isArray)
                 {
+                    // numchild is the number of children listed, which may be fewer than the array has
+                    _arrayLength = _arrayLength ?? CountChildren;
                     CountChildren = results.FindUint("numchild");
-                    Children = new VariableInformation[CountChildren];
+                    Children = new VariableInformation[children.Length];
                     foreach (var c in children)
                     {
                         Children[i] = new VariableInformation(c, this);
@@ -864,33 +1157,51 @@ namespace Microsoft.MIDebugEngine
                 }
                 else
                 {
-                    List<VariableInformation> listChildren = new List<VariableInformation>();
-                    foreach (var c in children)
+                    var variables = new VariableInformation[children.Length];
+                    var accessQualifiers = new List<VariableInformation>();
+                    for (int c = 0; c < children.Length; c++)
                     {
-                        var variable = new VariableInformation(c, this);
-                        enum_DBG_ATTRIB_FLAGS access = enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_NONE;
+                        var variable = new VariableInformation(children[c], this);
                         if (variable.Name == "public")
                         {
-                            access = enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_ACCESS_PUBLIC;
-                            variable.VariableNodeType = NodeType.AccessQualifier;
+                            variable.Access = enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_ACCESS_PUBLIC;
                         }
                         else if (variable.Name == "private")
                         {
-                            access = enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_ACCESS_PRIVATE;
-                            variable.VariableNodeType = NodeType.AccessQualifier;
+                            variable.Access = enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_ACCESS_PRIVATE;
                         }
                         else if (variable.Name == "protected")
                         {
-                            access = enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_ACCESS_PROTECTED;
+                            variable.Access = enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_ACCESS_PROTECTED;
+                        }
+                        if (variable.Access != enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_NONE)
+                        {
                             variable.VariableNodeType = NodeType.AccessQualifier;
+                            accessQualifiers.Add(variable);
                         }
-                        if (access != enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_NONE)
+                        variables[c] = variable;
+                    }
+
+                    if (accessQualifiers.Count != 0)
+                    {
+                        // Fetch the children of all the access qualifiers at once rather than one round trip each
+                        Results[] qualifierResults = await _engine.DebuggedProcess.MICommandFactory.VarListChildrenBatch(
+                            accessQualifiers.Select(q => q._internalName).ToList(), PropertyInfoFlags, ResultClass.None);
+                        for (int q = 0; q < accessQualifiers.Count; q++)
+                        {
+                            await accessQualifiers[q].ProcessChildren(qualifierResults[q]);
+                        }
+                    }
+
+                    List<VariableInformation> listChildren = new List<VariableInformation>();
+                    foreach (var variable in variables)
+                    {
+                        if (variable.VariableNodeType == NodeType.AccessQualifier)
                         {
                             // Add this child's children
-                            await variable.InternalFetchChildren();
                             foreach (var child in variable.Children)
                             {
-                                ((VariableInformation)child).Access = access;
+                                ((VariableInformation)child).Access = variable.Access;
                                 listChildren.Add(child);
                             }
                         }
@@ -910,10 +1221,8 @@ namespace Microsoft.MIDebugEngine
             }
             if (_format != null)
             {
-                foreach (var child in Children)
-                {
-                    await child.Format();
-                }
+                // The -var-set-format commands are independent, so let them all be in flight at once
+                await Task.WhenAll(Children.Select(child => child.Format()));
             }
         }
 
@@ -984,8 +1293,26 @@ namespace Microsoft.MIDebugEngine
                 int threadId = Client.GetDebuggedThread().Id;
                 uint frameLevel = _ctx.Level.Value;
 
+                string variableName = _internalName;
+                if (variableName == null)
+                {
+                    // array elements decoded from memory have no variable object of their own
+                    Results results = await _engine.DebuggedProcess.MICommandFactory.VarCreate(FullName(), threadId, frameLevel, 0);
+                    variableName = results.FindString("name");
+                }
+
                 _engine.DebuggedProcess.FlushBreakStateData();
-                Value = await _engine.DebuggedProcess.MICommandFactory.VarAssign(_internalName, expression, threadId, frameLevel);
+                try
+                {
+                    Value = await _engine.DebuggedProcess.MICommandFactory.VarAssign(variableName, expression, threadId, frameLevel);
+                }
+                finally
+                {
+                    if (variableName != _internalName)
+                    {
+                        await _engine.DebuggedProcess.MICommandFactory.VarDelete(variableName);
+                    }
+                }
             });
         }
 
@@ -1010,6 +1337,10 @@ namespace Microsoft.MIDebugEngine
 
         private void Dispose(bool isDisposing)
         {
+            if (_isDisposed)
+            {
+                return;
+            }
             _isDisposed = true;
 
             //mi -var-delete deletes all children, so only top level variables should be added to the delete list
@@ -1019,9 +1350,27 @@ namespace Microsoft.MIDebugEngine
             {
                 if (!_debuggedProcess.IsClosed)
                 {
-                    lock (_debuggedProcess.VariablesToDelete)
+                    string toDelete = _internalName;
+                    if (_poolKey.HasValue && !Error)
                     {
-                        _debuggedProcess.VariablesToDelete.Add(_internalName);
+                        // keep the variable object so the next stop can update it instead of creating a new one
+                        toDelete = _debuggedProcess.VariableObjects.Release(_poolKey.Value, new VariableObjectPool.Entry()
+                        {
+                            Name = _internalName,
+                            TypeName = TypeName,
+                            Value = Value,
+                            CountChildren = _arrayLength ?? CountChildren,
+                            DisplayHint = DisplayHint,
+                            IsReadOnly = _isReadonly,
+                            AttributesFetched = _attribsFetched
+                        });
+                    }
+                    if (toDelete != null)
+                    {
+                        lock (_debuggedProcess.VariablesToDelete)
+                        {
+                            _debuggedProcess.VariablesToDelete.Add(toDelete);
+                        }
                     }
                 }
             }
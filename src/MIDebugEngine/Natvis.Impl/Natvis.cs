@@ -13,6 +13,7 @@ using System.Linq;
 using System.Reflection;
 using System.Text;
 using System.Text.RegularExpressions;
+using System.Threading.Tasks;
 using System.Xml;
 using System.Xml.Serialization;
 
@@ -132,7 +133,8 @@ namespace Microsoft.MIDebugEngine.Natvis
         }
     }
     /// <summary>
-    /// Represents the continuation of a TreeItemsType.
+    /// Represents the continuation of a TreeItemsType. When Nodes is null the page was produced by a bulk walk, and
+    /// the next page is found by walking from ContinueNode again and skipping StartIndex nodes.
     /// </summary>
     internal sealed class TreeContinueWrapper : PaginatedVisualizerWrapper
     {
@@ -184,16 +186,16 @@ namespace Microsoft.MIDebugEngine.Natvis
         }
         private class FileInfo
         {
-            public List<TypeInfo> Visualizers { get; private set; }
-            public List<AliasInfo> Aliases { get; private set; }
+            public TypeNameIndex<TypeInfo> Visualizers { get; private set; }
+            public TypeNameIndex<AliasInfo> Aliases { get; private set; }
             public List<UIVisualizerType> UIVisualizers { get; set; } = null;
             public readonly AutoVisualizer Environment;
 
             public FileInfo(AutoVisualizer env)
             {
                 Environment = env;
-                Visualizers = new List<TypeInfo>();
-                Aliases = new List<AliasInfo>();
+                Visualizers = new TypeNameIndex<TypeInfo>(v => v.ParsedName);
+                Aliases = new TypeNameIndex<AliasInfo>(a => a.ParsedName);
             }
         }
 
@@ -252,12 +254,16 @@ namespace Microsoft.MIDebugEngine.Natvis
         private List<FileInfo> _typeVisualizers;
         private DebuggedProcess _process;
         private HostConfigurationStore _configStore;
-        private Dictionary<string, VisualizerInfo> _vizCache;
         private uint _depth;
+        private NodeWalker _nodeWalker;
         public HostWaitDialog WaitDialog { get; private set; }
 
         public VisualizationCache Cache { get; private set; }
 
+        // Constructing the serializer generates code for the natvis schema, so only do it once per process
+        private static readonly Lazy<XmlSerializer> s_serializer = new Lazy<XmlSerializer>(() => new XmlSerializer(typeof(AutoVisualizer)));
+        private static readonly NatvisFileCache<FileInfo> s_fileCache = new NatvisFileCache<FileInfo>();
+
         private const uint MAX_EXPAND = 50;
         private const int MAX_FORMAT_DEPTH = 10;
         private const int MAX_ALIAS_CHAIN = 10;
@@ -276,12 +282,15 @@ namespace Microsoft.MIDebugEngine.Natvis
         {
             _typeVisualizers = new List<FileInfo>();
             _process = process;
-            _vizCache = new Dictionary<string, VisualizerInfo>();
             WaitDialog = new HostWaitDialog(ResourceStrings.VisualizingExpressionMessage, ResourceStrings.VisualizingExpressionCaption);
             ShowDisplayStrings = showDisplayString ? DisplayStringsState.On : DisplayStringsState.ForVisualizedItems;  // don't compute display strings unless explicitly requested
             _depth = 0;
-            Cache = new VisualizationCache();
+            Cache = new VisualizationCache(process.Logger);
+            _nodeWalker = new NodeWalker(process);
             _configStore = configStore;
+
+            // Warm up the serializer while the rest of the launch proceeds
+            Task.Run(() => s_serializer.Value);
         }
 
         private void InitializeNatvisServices()
@@ -358,46 +367,79 @@ namespace Microsoft.MIDebugEngine.Natvis
             }
         }
 
-        [System.Diagnostics.CodeAnalysis.SuppressMessage("Microsoft.Security.Xml", "CA3053: UseSecureXmlResolver.",
-            Justification = "Usage is secure -- XmlResolver property is set to 'null' in desktop CLR, and is always null in CoreCLR. But CodeAnalysis cannot understand the invocation since it happens through reflection.")]
         private bool LoadFile(string path)
         {
             try
             {
-                XmlSerializer serializer = new XmlSerializer(typeof(AutoVisualizer));
                 if (!File.Exists(path))
                 {
                     _process.Logger.NatvisLogger?.WriteLine(LogLevel.Error, ResourceStrings.FileNotFound, path);
                     return false;
                 }
-                XmlReaderSettings settings = new XmlReaderSettings();
-                settings.IgnoreComments = true;
-                settings.IgnoreProcessingInstructions = true;
-                settings.IgnoreWhitespace = true;
-
-                // set XmlResolver via reflection, if it exists. This is required for desktop CLR, as otherwise the XML reader may
-                // attempt to hit untrusted external resources.
-                var xmlResolverProperty = settings.GetType().GetProperty("XmlResolver", BindingFlags.Public | BindingFlags.Instance);
-                xmlResolverProperty?.SetValue(settings, null);
-
-                using (var stream = new System.IO.FileStream(path, FileMode.Open, FileAccess.Read))
-                using (var reader = XmlReader.Create(stream, settings))
+
+                FileInfo f = s_fileCache.GetOrLoad(path, ParseFile, out bool fromCache);
+                if (f == null)
+                {
+                    return false;
+                }
+                if (fromCache)
                 {
-                    AutoVisualizer autoVis = null;
-                    autoVis = serializer.Deserialize(reader) as AutoVisualizer;
-                    if (autoVis != null)
+                    _process.Logger.NatvisLogger?.WriteLine(LogLevel.Verbose, "Reusing previously parsed natvis file: {0}", path);
+                }
+                _typeVisualizers.Add(f);
+                Cache.FlushVisualizers();
+                return true;
+            }
+            catch (Exception exception)
+            {
+                // don't allow natvis failures to stop debugging
+                _process.Logger.NatvisLogger?.WriteLine(LogLevel.Error, ResourceStrings.ErrorReadingFile, exception.Message, path);
+                return false;
+            }
+        }
+
+        [System.Diagnostics.CodeAnalysis.SuppressMessage("Microsoft.Security.Xml", "CA3053: UseSecureXmlResolver.",
+            Justification = "Usage is secure -- XmlResolver property is set to 'null' in desktop CLR, and is always null in CoreCLR. But CodeAnalysis cannot understand the invocation since it happens through reflection.")]
+        private FileInfo ParseFile(Stream stream)
+        {
+            XmlReaderSettings settings = new XmlReaderSettings();
+            settings.IgnoreComments = true;
+            settings.IgnoreProcessingInstructions = true;
+            settings.IgnoreWhitespace = true;
+
+            // set XmlResolver via reflection, if it exists. This is required for desktop CLR, as otherwise the XML reader may
+            // attempt to hit untrusted external resources.
+            var xmlResolverProperty = settings.GetType().GetProperty("XmlResolver", BindingFlags.Public | BindingFlags.Instance);
+            xmlResolverProperty?.SetValue(settings, null);
+
+            using (var reader = XmlReader.Create(stream, settings))
+            {
+                AutoVisualizer autoVis = s_serializer.Value.Deserialize(reader) as AutoVisualizer;
+                if (autoVis == null || autoVis.Items == null)
+                {
+                    return null;
+                }
+
+                FileInfo f = new FileInfo(autoVis);
+                foreach (var o in autoVis.Items)
+                {
+                    if (o is VisualizerType)
                     {
-                        FileInfo f = new FileInfo(autoVis);
-                        if (autoVis.Items == null)
+                        VisualizerType v = (VisualizerType)o;
+                        TypeName t = TypeName.Parse(v.Name, _process.Logger.NatvisLogger);
+                        if (t != null)
                         {
-                            return false;
+                            lock (_typeVisualizers)
+                            {
+                                f.Visualizers.Add(new TypeInfo(t, v));
+                            }
                         }
-                        foreach (var o in autoVis.Items)
+                        // add an entry for each alternative name too
+                        if (v.AlternativeType != null)
                         {
-                            if (o is VisualizerType)
+                            foreach (var a in v.AlternativeType)
                             {
-                                VisualizerType v = (VisualizerType)o;
-                                TypeName t = TypeName.Parse(v.Name, _process.Logger.NatvisLogger);
+                                t = TypeName.Parse(a.Name, _process.Logger.NatvisLogger);
                                 if (t != null)
                                 {
                                     lock (_typeVisualizers)
@@ -405,51 +447,28 @@ namespace Microsoft.MIDebugEngine.Natvis
                                         f.Visualizers.Add(new TypeInfo(t, v));
                                     }
                                 }
-                                // add an entry for each alternative name too
-                                if (v.AlternativeType != null)
-                                {
-                                    foreach (var a in v.AlternativeType)
-                                    {
-                                        t = TypeName.Parse(a.Name, _process.Logger.NatvisLogger);
-                                        if (t != null)
-                                        {
-                                            lock (_typeVisualizers)
-                                            {
-                                                f.Visualizers.Add(new TypeInfo(t, v));
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                            else if (o is AliasType)
-                            {
-                                AliasType a = (AliasType)o;
-                                TypeName t = TypeName.Parse(a.Name, _process.Logger.NatvisLogger);
-                                if (t != null)
-                                {
-                                    lock (_typeVisualizers)
-                                    {
-                                        f.Aliases.Add(new AliasInfo(t, a));
-                                    }
-                                }
                             }
                         }
-
-                        if (autoVis.UIVisualizer != null)
+                    }
+                    else if (o is AliasType)
+                    {
+                        AliasType a = (AliasType)o;
+                        TypeName t = TypeName.Parse(a.Name, _process.Logger.NatvisLogger);
+                        if (t != null)
                         {
-                            f.UIVisualizers = autoVis.UIVisualizer.ToList();
+                            lock (_typeVisualizers)
+                            {
+                                f.Aliases.Add(new AliasInfo(t, a));
+                            }
                         }
-
-                        _typeVisualizers.Add(f);
                     }
-                    return autoVis != null;
                 }
-            }
-            catch (Exception exception)
-            {
-                // don't allow natvis failures to stop debugging
-                _process.Logger.NatvisLogger?.WriteLine(LogLevel.Error, ResourceStrings.ErrorReadingFile, exception.Message, path);
-                return false;
+
+                if (autoVis.UIVisualizer != null)
+                {
+                    f.UIVisualizers = autoVis.UIVisualizer.ToList();
+                }
+                return f;
             }
         }
 
@@ -751,13 +770,16 @@ namespace Microsoft.MIDebugEngine.Natvis
                         Traverse goLeft = GetTraverse(item.LeftPointer, headVal);
                         Traverse goRight = GetTraverse(item.RightPointer, headVal);
                         Traverse getValue = null;
+                        string valueMember = null;
                         if (item.ValueNode.Value == "this") // TODO: handle condition
                         {
                             getValue = (v) => v;
+                            valueMember = item.ValueNode.Value;
                         }
                         else if (headVal.FindChildByName(item.ValueNode.Value) != null)
                         {
                             getValue = (v) => v.FindChildByName(item.ValueNode.Value);
+                            valueMember = item.ValueNode.Value;
                         }
                         else if (GetExpression(item.ValueNode.Value, headVal, visualizer.ScopedNames, intrinsics: visualizer.Intrinsics) != null)
                         {
@@ -778,7 +800,10 @@ namespace Microsoft.MIDebugEngine.Natvis
                         {
                             parent = simpleWrapper.Parent;
                         }
-                        TraverseTree(headVal, goLeft, goRight, getValue, children, size, variable, parent, startIndex);
+                        if (valueMember == null || !TraverseTreeInBulk(headVal, item.LeftPointer, item.RightPointer, valueMember, children, size, variable, parent, startIndex))
+                        {
+                            TraverseTree(headVal, goLeft, goRight, getValue, children, size, variable, parent, startIndex);
+                        }
                     }
                 }
                 else if (i is LinkedListItemsType)
@@ -826,13 +851,16 @@ namespace Microsoft.MIDebugEngine.Natvis
                         headVal.EnsureChildren();
                         Traverse goNext = GetTraverse(item.NextPointer, headVal);
                         Traverse getValue = null;
+                        string valueMember = null;
                         if (item.ValueNode == "this")
                         {
                             getValue = (v) => v;
+                            valueMember = item.ValueNode;
                         }
                         else if (headVal.FindChildByName(item.ValueNode) != null)
                         {
                             getValue = (v) => v.FindChildByName(item.ValueNode);
+                            valueMember = item.ValueNode;
                         }
                         else
                         {
@@ -857,7 +885,10 @@ namespace Microsoft.MIDebugEngine.Natvis
                         {
                             parent = simpleWrapper.Parent;
                         }
-                        TraverseList(headVal, goNext, getValue, children, size, item.NoValueHeadPointer, parent, startIndex);
+                        if (valueMember == null || !TraverseListInBulk(headVal, item.NextPointer, valueMember, children, size, item.NoValueHeadPointer, parent, startIndex))
+                        {
+                            TraverseList(headVal, goNext, getValue, children, size, item.NoValueHeadPointer, parent, startIndex);
+                        }
                     }
                 }
                 else if (i is IndexListItemsType)
@@ -1013,14 +1044,20 @@ namespace Microsoft.MIDebugEngine.Natvis
         private void TraverseTree(IVariableInformation root, Traverse goLeft, Traverse goRight, Traverse getValue, List<IVariableInformation> content, uint size, IVariableInformation variable, IVariableInformation parent, uint startIndex)
         {
             uint i = startIndex;
+            uint skip = 0;
             var nodes = new Stack<Node>();
-            if (variable is TreeContinueWrapper tcwVariable)
+            if (variable is TreeContinueWrapper tcwVariable && tcwVariable.Nodes != null)
             {
                 nodes = tcwVariable.Nodes;
             }
             else
             {
                 nodes.Push(new Node(root));
+                if (variable is TreeContinueWrapper)
+                {
+                    // continuing a page produced by TraverseTreeInBulk, re-walk from the root
+                    skip = startIndex;
+                }
             }
 
             uint maxIndex = i + MAX_EXPAND > size ? size : i + MAX_EXPAND;
@@ -1042,6 +1079,11 @@ namespace Microsoft.MIDebugEngine.Natvis
                         break;
                     case Node.ScanState.value:
                         nodes.Peek().State = Node.ScanState.right;
+                        if (skip > 0)
+                        {
+                            skip--;
+                            break;
+                        }
                         IVariableInformation value = getValue(nodes.Peek().Content);
                         if (value != null)
                         {
@@ -1107,6 +1149,107 @@ namespace Microsoft.MIDebugEngine.Natvis
             }
         }
 
+        /// <summary>
+        /// Bulk version of TraverseTree: the in-order walk runs inside gdb and the values of the page are evaluated
+        /// together. Returns false if the walk isn't possible, in which case nothing has been added to content.
+        /// </summary>
+        private bool TraverseTreeInBulk(IVariableInformation root, string leftPointer, string rightPointer, string valueMember, List<IVariableInformation> content, uint size, IVariableInformation variable, IVariableInformation parent, uint startIndex)
+        {
+            if (variable is TreeContinueWrapper tcwVariable && tcwVariable.Nodes != null)
+            {
+                return false;   // the previous page came from TraverseTree, keep using its traversal state
+            }
+            if (startIndex >= size || !NodeWalker.IsValueMember(valueMember))
+            {
+                return false;
+            }
+
+            uint maxIndex = startIndex + MAX_EXPAND > size ? size : startIndex + MAX_EXPAND;
+            uint count = maxIndex - startIndex;
+            List<ulong> nodes = _nodeWalker.WalkTree(root.TypeName, MICore.Debugger.ParseAddr(root.Value), leftPointer, rightPointer, startIndex, count, size);
+            if (nodes == null)
+            {
+                return false;
+            }
+
+            uint i = AddNodeValues(root, nodes, valueMember, content, startIndex);
+            if (size > i && nodes.Count == count)
+            {
+                IVariableInformation tcw = new TreeContinueWrapper(ResourceStrings.MoreView, _process.Engine, parent, FindType(parent), isVisualizerView: true, new Node(root), null, i);
+                content.Add(tcw);
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// Bulk version of TraverseList: the links are followed inside gdb and the values of the page are evaluated
+        /// together. Returns false if the walk isn't possible, in which case nothing has been added to content.
+        /// </summary>
+        private bool TraverseListInBulk(IVariableInformation root, string nextPointer, string valueMember, List<IVariableInformation> content, uint size, bool noValueInRoot, IVariableInformation parent, uint startIndex)
+        {
+            if (startIndex >= size || !NodeWalker.IsValueMember(valueMember))
+            {
+                return false;
+            }
+            uint maxIndex = startIndex + MAX_EXPAND > size ? size : startIndex + MAX_EXPAND;
+            uint count = maxIndex - startIndex + (noValueInRoot ? 1u : 0u);
+            ulong rootAddr = MICore.Debugger.ParseAddr(root.Value);
+            List<ulong> nodes = _nodeWalker.WalkList(root.TypeName, rootAddr, nextPointer, count, out ulong continueAddr);
+            if (nodes == null)
+            {
+                return false;
+            }
+            if (noValueInRoot && nodes.Count > 0 && nodes[0] == rootAddr)
+            {
+                nodes.RemoveAt(0);
+            }
+
+            uint i = AddNodeValues(root, nodes, valueMember, content, startIndex);
+            if (size > i && continueAddr != 0)
+            {
+                var continueNode = new VariableInformation(NodeExpression(root.TypeName, continueAddr), root, _process.Engine, "");
+                continueNode.SyncEval();
+                IVariableInformation llcw = new LinkedListContinueWrapper(ResourceStrings.MoreView, _process.Engine, parent, FindType(parent), isVisualizerView: true, continueNode, i);
+                content.Add(llcw);
+            }
+            return true;
+        }
+
+        private uint AddNodeValues(IVariableInformation root, List<ulong> nodes, string valueMember, List<IVariableInformation> content, uint startIndex)
+        {
+            var values = new List<VariableInformation>(nodes.Count);
+            foreach (ulong addr in nodes)
+            {
+                string expr = NodeExpression(root.TypeName, addr);
+                if (valueMember != "this")
+                {
+                    expr = "(" + expr + ")->" + valueMember;
+                }
+                values.Add(new VariableInformation(expr, root, _process.Engine, ""));
+            }
+
+            // Issue the -var-create commands together rather than waiting on each one in turn
+            uint radix = _process.Engine.CurrentRadix();
+            Task.Run(async () =>
+            {
+                await _process.Engine.UpdateRadixAsync(radix);
+                await Task.WhenAll(values.Select(v => v.Eval(0)));
+            }).Wait();
+
+            uint i = startIndex;
+            foreach (VariableInformation value in values)
+            {
+                content.Add(new SimpleWrapper("[" + i.ToString(CultureInfo.InvariantCulture) + "]", _process.Engine, value));
+                i++;
+            }
+            return i;
+        }
+
+        private static string NodeExpression(string nodeType, ulong addr)
+        {
+            return "(" + nodeType + ")" + string.Format(CultureInfo.InvariantCulture, "0x{0:x}", addr);
+        }
+
         private static string BaseName(string type)
         {
             type = type.TrimEnd();
@@ -1132,9 +1275,13 @@ namespace Microsoft.MIDebugEngine.Natvis
             return res;
         }
 
-        private IVariableInformation FindBaseClass(IVariableInformation variable)
+        /// <param name="childrenListed">false if the children couldn't be listed, e.g. after a -var-list-children error</param>
+        private IVariableInformation FindBaseClass(IVariableInformation variable, out bool childrenListed)
         {
+            uint expectedChildren = variable.CountChildren;
             variable.EnsureChildren();
+            // a failed -var-list-children leaves a variable that should have children with none
+            childrenListed = !variable.Error && (expectedChildren == 0 || (variable.Children != null && variable.Children.Length != 0));
             if (variable.Children != null)
             {
                 return Array.Find(variable.Children, (c) => c.VariableNodeType == VariableInformation.NodeType.BaseClass);
@@ -1148,17 +1295,18 @@ namespace Microsoft.MIDebugEngine.Natvis
         tryAgain:
             foreach (var autoVis in _typeVisualizers)
             {
-                var visualizer = FindBestMatch(autoVis.Visualizers, name, v => v.ParsedName);
+                var visualizer = FindBestMatch(autoVis.Visualizers.Find(name), name, v => v.ParsedName);
                 if (visualizer != null)
                 {
-                    _vizCache[variable.TypeName] = new VisualizerInfo(visualizer.Visualizer, name);
-                    return _vizCache[variable.TypeName];
+                    var info = new VisualizerInfo(visualizer.Visualizer, name);
+                    Cache.AddVisualizer(variable.TypeName, info);
+                    return info;
                 }
             }
             // failed to find a visualizer for the type, try looking for a typedef
             foreach (var autoVis in _typeVisualizers)
             {
-                var alias = FindBestMatch(autoVis.Aliases, name, a => a.ParsedName);
+                var alias = FindBestMatch(autoVis.Aliases.Find(name), name, a => a.ParsedName);
                 if (alias != null)
                 {
                     // add the template parameter macro values
@@ -1226,18 +1374,24 @@ namespace Microsoft.MIDebugEngine.Natvis
             return best;
         }
 
+        internal bool HasVisualizer(IVariableInformation variable)
+        {
+            return FindType(variable) != null;
+        }
+
         private VisualizerInfo FindType(IVariableInformation variable)
         {
             if (variable is VisualizerWrapper)
             {
                 return ((VisualizerWrapper)variable).Visualizer;
             }
-            if (_vizCache.ContainsKey(variable.TypeName))
+            if (Cache.TryGetVisualizer(variable.TypeName, out VisualizerInfo cached))
             {
-                return _vizCache[variable.TypeName];
+                return cached;
             }
             TypeName parsedName = TypeName.Parse(variable.TypeName, _process.Logger.NatvisLogger);
             IVariableInformation var = variable;
+            bool walkFinished = false;
             while (parsedName != null)
             {
                 var visualizer = Scan(parsedName, variable);
@@ -1250,13 +1404,20 @@ namespace Microsoft.MIDebugEngine.Natvis
                 {
                     return visualizer;
                 }
-                var = FindBaseClass(var);   // TODO: handle more than one base class?
+                var = FindBaseClass(var, out bool childrenListed);   // TODO: handle more than one base class?
                 if (var == null)
                 {
+                    walkFinished = childrenListed;
                     break;
                 }
                 parsedName = TypeName.Parse(var.TypeName, _process.Logger.NatvisLogger);
             }
+            if (walkFinished && !variable.Error)
+            {
+                // remember that the type has no visualizer so the next lookup doesn't scan again. Not if the base classes
+                // couldn't be listed, that may only be transient
+                Cache.AddVisualizer(variable.TypeName, null);
+            }
             return null;
         }
 
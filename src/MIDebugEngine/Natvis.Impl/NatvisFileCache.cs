@@ -0,0 +1,80 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Security.Cryptography;
+
+namespace Microsoft.MIDebugEngine.Natvis
+{
+    /// <summary>
+    /// Process wide cache of parsed natvis files. An entry is reused while the file's length, last write time and
+    /// content hash are unchanged, so debug sessions hosted by the same process don't deserialize and parse the same
+    /// natvis files again. Parsed files must not be modified after they are added.
+    /// </summary>
+    internal sealed class NatvisFileCache<T> where T : class
+    {
+        private sealed class Entry
+        {
+            public long Length;
+            public DateTime LastWriteTimeUtc;
+            public byte[] Hash;
+            public T Value;
+        }
+
+        private readonly Dictionary<string, Entry> _entries = new Dictionary<string, Entry>(StringComparer.Ordinal);
+
+        /// <summary>
+        /// Returns the cached parse of 'path' if the file is unchanged, otherwise parses it with 'load'. Null results
+        /// aren't cached.
+        /// </summary>
+        public T GetOrLoad(string path, Func<Stream, T> load, out bool fromCache)
+        {
+            string fullPath = Path.GetFullPath(path);
+            System.IO.FileInfo info = new System.IO.FileInfo(fullPath);
+            long length = info.Length;
+            DateTime lastWriteTimeUtc = info.LastWriteTimeUtc;
+
+            byte[] content = File.ReadAllBytes(fullPath);
+            byte[] hash;
+            using (SHA256 sha = SHA256.Create())
+            {
+                hash = sha.ComputeHash(content);
+            }
+
+            lock (_entries)
+            {
+                if (_entries.TryGetValue(fullPath, out Entry entry)
+                    && entry.Length == length
+                    && entry.LastWriteTimeUtc == lastWriteTimeUtc
+                    && entry.Hash.SequenceEqual(hash))
+                {
+                    fromCache = true;
+                    return entry.Value;
+                }
+            }
+
+            fromCache = false;
+            T value;
+            using (var stream = new MemoryStream(content, writable: false))
+            {
+                value = load(stream);
+            }
+
+            lock (_entries)
+            {
+                if (value != null)
+                {
+                    _entries[fullPath] = new Entry() { Length = length, LastWriteTimeUtc = lastWriteTimeUtc, Hash = hash, Value = value };
+                }
+                else
+                {
+                    _entries.Remove(fullPath);
+                }
+            }
+            return value;
+        }
+    }
+}
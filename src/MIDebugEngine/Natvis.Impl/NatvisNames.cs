@@ -351,4 +351,101 @@ namespace Microsoft.MIDebugEngine.Natvis
             return true;
         }
     }
+
+    /// <summary>
+    /// Index of natvis type patterns keyed on qualifier count, base name and template arity, so that a lookup only
+    /// runs TypeName.Match over the few patterns that could match. Patterns ending in a wildcard template argument
+    /// and the bare "*" pattern are kept in separate buckets. Candidates are returned in the order they were added.
+    /// </summary>
+    internal class TypeNameIndex<T> where T : class
+    {
+        private struct Entry
+        {
+            public int Order;
+            public T Item;
+        }
+
+        private static readonly List<Entry> s_empty = new List<Entry>();
+
+        private readonly Func<T, TypeName> _getParsedName;
+        private readonly Dictionary<string, List<Entry>> _fixedArity = new Dictionary<string, List<Entry>>(StringComparer.Ordinal);
+        private readonly Dictionary<string, List<Entry>> _variadic = new Dictionary<string, List<Entry>>(StringComparer.Ordinal);
+        private readonly List<Entry> _wildcards = new List<Entry>();
+
+        public int Count { get; private set; }
+
+        public TypeNameIndex(Func<T, TypeName> getParsedName)
+        {
+            _getParsedName = getParsedName;
+        }
+
+        public void Add(T item)
+        {
+            TypeName pattern = _getParsedName(item);
+            Entry entry = new Entry() { Order = Count++, Item = item };
+
+            List<Entry> bucket;
+            if (pattern.IsWildcard)
+            {
+                bucket = _wildcards;
+            }
+            else if (pattern.Args.Count > 0 && pattern.Args[pattern.Args.Count - 1].IsWildcard)
+            {
+                bucket = GetBucket(_variadic, NameKey(pattern));
+            }
+            else
+            {
+                bucket = GetBucket(_fixedArity, ArityKey(pattern, pattern.Args.Count));
+            }
+            bucket.Add(entry);
+        }
+
+        /// <summary>
+        /// Returns the patterns that may match 'name'. The caller still has to check each one with TypeName.Match.
+        /// </summary>
+        public List<T> Find(TypeName name)
+        {
+            List<Entry> fixedArity, variadic;
+            if (!_fixedArity.TryGetValue(ArityKey(name, name.Args.Count), out fixedArity))
+            {
+                fixedArity = s_empty;
+            }
+            if (name.Args.Count == 0 || !_variadic.TryGetValue(NameKey(name), out variadic))
+            {
+                variadic = s_empty;
+            }
+
+            var entries = new List<Entry>(fixedArity.Count + variadic.Count + _wildcards.Count);
+            entries.AddRange(fixedArity);
+            entries.AddRange(variadic);
+            entries.AddRange(_wildcards);
+            if (entries.Count != fixedArity.Count)
+            {
+                // restore the original order so ties are resolved the same way as a linear scan
+                entries.Sort((x, y) => x.Order - y.Order);
+            }
+            return entries.ConvertAll(e => e.Item);
+        }
+
+        private static List<Entry> GetBucket(Dictionary<string, List<Entry>> buckets, string key)
+        {
+            List<Entry> bucket;
+            if (!buckets.TryGetValue(key, out bucket))
+            {
+                bucket = new List<Entry>();
+                buckets.Add(key, bucket);
+            }
+            return bucket;
+        }
+
+        private static string NameKey(TypeName name)
+        {
+            return name.Qualifiers.Count.ToString(CultureInfo.InvariantCulture) + "|" + name.BaseName;
+        }
+
+        private static string ArityKey(TypeName name, int arity)
+        {
+            return NameKey(name) + "|" + arity.ToString(CultureInfo.InvariantCulture);
+        }
+    }
 }
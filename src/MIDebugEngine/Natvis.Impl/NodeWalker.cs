@@ -0,0 +1,158 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using MICore;
+using Microsoft.DebugEngineHost;
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Text.RegularExpressions;
+using System.Threading.Tasks;
+
+namespace Microsoft.MIDebugEngine.Natvis
+{
+    /// <summary>
+    /// Walks the links of LinkedListItems and TreeItems nodes inside gdb with a single Python command, instead of
+    /// creating a variable object for every node visited. Returns null whenever the walk can't be done this way
+    /// so the caller can fall back to the per-node traversal.
+    /// </summary>
+    internal sealed class NodeWalker
+    {
+        private const string ResultMarker = "@natvis-nodes:";
+
+        private static readonly Regex s_memberName = new Regex(@"^[A-Za-z_][A-Za-z0-9_]*$", RegexOptions.Compiled);
+
+        private readonly DebuggedProcess _process;
+        private bool _disabled;
+        private bool _succeeded;
+
+        public NodeWalker(DebuggedProcess process)
+        {
+            _process = process;
+        }
+
+        /// <summary>
+        /// Returns the addresses of up to 'count' list nodes starting at 'head', following the 'next' member. 'continueAddr'
+        /// receives the node after the last one returned, or 0 when the list ended or looped back to 'head'.
+        /// </summary>
+        public List<ulong> WalkList(string nodeType, ulong head, string next, uint count, out ulong continueAddr)
+        {
+            continueAddr = 0;
+            if (!CanWalk(nodeType, next))
+            {
+                return null;
+            }
+
+            string script = string.Format(CultureInfo.InvariantCulture,
+                "n=gdb.parse_and_eval('({0})0x{1:x}');t=n.type;h=int(n);o=[]\\n" +
+                "while int(n)!=0 and len(o)<{2}:\\n" +
+                " o.append(int(n));n=n.dereference()['{3}'].cast(t)\\n" +
+                " if int(n)==h: n=0;break\\n" +
+                "o.append(int(n))\\n",
+                nodeType, head, count, next);
+
+            List<ulong> nodes = Run(script);
+            if (nodes == null || nodes.Count == 0)
+            {
+                return null;
+            }
+            continueAddr = nodes[nodes.Count - 1];
+            nodes.RemoveAt(nodes.Count - 1);
+            return nodes;
+        }
+
+        /// <summary>
+        /// Returns the addresses of up to 'count' tree nodes in in-order sequence, skipping the first 'skip' nodes.
+        /// 'size' bounds the walk so a corrupted tree can't keep gdb busy forever.
+        /// </summary>
+        public List<ulong> WalkTree(string nodeType, ulong root, string left, string right, uint skip, uint count, uint size)
+        {
+            if (!CanWalk(nodeType, left) || !s_memberName.IsMatch(right))
+            {
+                return null;
+            }
+
+            string script = string.Format(CultureInfo.InvariantCulture,
+                "n=gdb.parse_and_eval('({0})0x{1:x}');t=n.type;o=[];s=[];k={2};g={5}\\n" +
+                "while (s or int(n)!=0) and len(o)<{3} and g>0:\\n" +
+                " g-=1\\n" +
+                " if int(n)!=0: s.append(n);n=n.dereference()['{6}'].cast(t);continue\\n" +
+                " n=s.pop()\\n" +
+                " if k>0: k-=1\\n" +
+                " else: o.append(int(n))\\n" +
+                " n=n.dereference()['{4}'].cast(t)\\n",
+                nodeType, root, skip, count, right, 3UL * size + 3, left);
+
+            return Run(script);
+        }
+
+        /// <summary>
+        /// Checks that the value of a node can be read as '(node)->valueMember', or is the node itself
+        /// </summary>
+        public static bool IsValueMember(string valueMember)
+        {
+            return valueMember == "this" || s_memberName.IsMatch(valueMember);
+        }
+
+        private bool CanWalk(string nodeType, string member)
+        {
+            return !_disabled
+                && _process.MICommandFactory.Mode == MIMode.Gdb
+                && !string.IsNullOrEmpty(nodeType)
+                && nodeType.IndexOfAny(new char[] { '\'', '"', '\\' }) < 0
+                && s_memberName.IsMatch(member);
+        }
+
+        private List<ulong> Run(string script)
+        {
+            string command = "python exec(\"" + script + "print('" + ResultMarker + "'+' '.join('%x'%a for a in o))\")";
+            string output = null;
+            try
+            {
+                Task.Run(async () =>
+                {
+                    output = await _process.ConsoleCmdAsync(command, allowWhileRunning: false, ignoreFailures: true);
+                }).Wait();
+            }
+            catch (Exception e)
+            {
+                _process.Logger.NatvisLogger?.WriteLine(LogLevel.Verbose, "Natvis node walk failed: " + e.Message);
+                return null;
+            }
+
+            List<ulong> nodes = Parse(output);
+            if (nodes == null)
+            {
+                // Without a single successful walk the most likely cause is a gdb built without Python, so stop trying.
+                // Once a walk has worked a failure is specific to the data being walked.
+                _disabled = !_succeeded;
+                return null;
+            }
+            _succeeded = true;
+            return nodes;
+        }
+
+        internal static List<ulong> Parse(string output)
+        {
+            int start = output?.LastIndexOf(ResultMarker, StringComparison.Ordinal) ?? -1;
+            if (start < 0)
+            {
+                return null;
+            }
+            start += ResultMarker.Length;
+            int end = output.IndexOf('\n', start);
+            string line = end < 0 ? output.Substring(start) : output.Substring(start, end - start);
+
+            var nodes = new List<ulong>();
+            foreach (string token in line.Split(new char[] { ' ' }, StringSplitOptions.RemoveEmptyEntries))
+            {
+                if (!ulong.TryParse(token.Trim(), NumberStyles.AllowHexSpecifier, CultureInfo.InvariantCulture, out ulong addr))
+                {
+                    return null;
+                }
+                nodes.Add(addr);
+            }
+            return nodes;
+        }
+    }
+}
@@ -1,9 +1,12 @@
 ﻿// Copyright (c) Microsoft. All rights reserved.
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
+using MICore;
+using Microsoft.DebugEngineHost;
 using System;
 using System.Collections.Generic;
 using System.Diagnostics;
+using System.Globalization;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
@@ -12,11 +15,18 @@ namespace Microsoft.MIDebugEngine.Natvis
 {
     public class VisualizationCache
     {
+        // Visualized views displayed during the current break state, keyed by expression, thread and frame
+        private const int MaxWrapperEntries = 1024;
+        // Visualizer chosen for each type name. The choice only depends on the type name and the loaded natvis
+        // files, so these entries survive break state changes.
+        private const int MaxVisualizerEntries = 4096;
+
         private struct VisualizerKey : IEquatable<VisualizerKey>, IComparable<VisualizerKey>
         {
-            private string _name;
-            private int _threadId;
-            private int _level;
+            private readonly string _name;
+            private readonly int _threadId;
+            private readonly int _level;
+            private readonly int _hash;
 
             public VisualizerKey(IVariableInformation variable)
             {
@@ -27,6 +37,7 @@ namespace Microsoft.MIDebugEngine.Natvis
                 // keep the key total in the null case rather than throwing.
                 Debug.Assert(variable.ThreadContext.Level.HasValue, "How are we getting a variable from a synthetic thread context?");
                 _level = (int)(variable.ThreadContext.Level ?? 0);
+                _hash = ComputeHash(_name, _threadId, _level);
             }
 
             public VisualizerKey(string name, int threadId, int level)
@@ -34,6 +45,18 @@ namespace Microsoft.MIDebugEngine.Natvis
                 _name = name;
                 _threadId = threadId;
                 _level = level;
+                _hash = ComputeHash(_name, _threadId, _level);
+            }
+
+            private static int ComputeHash(string name, int threadId, int level)
+            {
+                unchecked
+                {
+                    int hash = name == null ? 0 : StringComparer.Ordinal.GetHashCode(name);
+                    hash = (hash * 397) ^ threadId;
+                    hash = (hash * 397) ^ level;
+                    return hash;
+                }
             }
 
             public int CompareTo(VisualizerKey other)
@@ -52,25 +75,102 @@ namespace Microsoft.MIDebugEngine.Natvis
 
             public bool Equals(VisualizerKey other)
             {
-                return CompareTo(other) == 0;
+                return _hash == other._hash
+                    && _threadId == other._threadId
+                    && _level == other._level
+                    && string.Equals(_name, other._name, StringComparison.Ordinal);
             }
 
             public override bool Equals(object obj)
             {
-                return Equals((VisualizerKey)obj);
+                return obj is VisualizerKey other && Equals(other);
             }
 
             public override int GetHashCode()
             {
-                return base.GetHashCode();
+                return _hash;
             }
         }
 
-        private Dictionary<VisualizerKey, VisualizerWrapper> _cache;
+        /// <summary>
+        /// Dictionary that evicts the least recently used entry once it holds 'capacity' entries. Not thread safe.
+        /// </summary>
+        private sealed class LruCache<TKey, TValue>
+        {
+            private readonly int _capacity;
+            private readonly Dictionary<TKey, LinkedListNode<KeyValuePair<TKey, TValue>>> _map;
+            private readonly LinkedList<KeyValuePair<TKey, TValue>> _order = new LinkedList<KeyValuePair<TKey, TValue>>();
+
+            public long Hits { get; private set; }
+            public long Misses { get; private set; }
+            public long Evictions { get; private set; }
 
-        internal VisualizationCache()
+            public LruCache(int capacity, IEqualityComparer<TKey> comparer = null)
+            {
+                _capacity = capacity;
+                _map = new Dictionary<TKey, LinkedListNode<KeyValuePair<TKey, TValue>>>(comparer);
+            }
+
+            public int Count => _map.Count;
+
+            public bool TryGetValue(TKey key, out TValue value)
+            {
+                if (_map.TryGetValue(key, out LinkedListNode<KeyValuePair<TKey, TValue>> node))
+                {
+                    if (node != _order.First)
+                    {
+                        _order.Remove(node);
+                        _order.AddFirst(node);
+                    }
+                    Hits++;
+                    value = node.Value.Value;
+                    return true;
+                }
+                Misses++;
+                value = default(TValue);
+                return false;
+            }
+
+            public void Set(TKey key, TValue value, bool overwrite)
+            {
+                if (_map.TryGetValue(key, out LinkedListNode<KeyValuePair<TKey, TValue>> node))
+                {
+                    if (overwrite)
+                    {
+                        node.Value = new KeyValuePair<TKey, TValue>(key, value);
+                    }
+                    return;
+                }
+                if (_map.Count >= _capacity)
+                {
+                    _map.Remove(_order.Last.Value.Key);
+                    _order.RemoveLast();
+                    Evictions++;
+                }
+                _map.Add(key, _order.AddFirst(new KeyValuePair<TKey, TValue>(key, value)));
+            }
+
+            public void Clear()
+            {
+                _map.Clear();
+                _order.Clear();
+            }
+
+            public override string ToString()
+            {
+                return string.Format(CultureInfo.InvariantCulture, "{0} entries, {1} hits, {2} misses, {3} evictions", Count, Hits, Misses, Evictions);
+            }
+        }
+
+        private readonly LruCache<VisualizerKey, VisualizerWrapper> _cache;
+        private readonly LruCache<string, Natvis.VisualizerInfo> _visualizers;
+        private readonly Logger _logger;
+
+        internal VisualizationCache(Logger logger = null)
         {
-            _cache = new Dictionary<VisualizerKey, VisualizerWrapper>();
+            _cache = new LruCache<VisualizerKey, VisualizerWrapper>(MaxWrapperEntries);
+            _visualizers = new LruCache<string, Natvis.VisualizerInfo>(MaxVisualizerEntries, StringComparer.Ordinal);
+            _logger = logger;
         }
 
         internal void Add(IVariableInformation var)
@@ -79,9 +179,7 @@ namespace Microsoft.MIDebugEngine.Natvis
             {
                 lock (_cache)
                 {
-                    VisualizerKey key = new VisualizerKey(var);
-                    if (!_cache.ContainsKey(key))
-                        _cache.Add(key, (var as VisualizerWrapper));
+                    _cache.Set(new VisualizerKey(var), (var as VisualizerWrapper), overwrite: false);
                 }
             }
         }
@@ -126,12 +224,46 @@ namespace Microsoft.MIDebugEngine.Natvis
             return var;
         }
 
+        /// <summary>
+        /// Look up the visualizer previously chosen for a type name.
+        /// </summary>
+        internal bool TryGetVisualizer(string typeName, out Natvis.VisualizerInfo visualizer)
+        {
+            lock (_visualizers)
+            {
+                return _visualizers.TryGetValue(typeName, out visualizer);
+            }
+        }
+
+        internal void AddVisualizer(string typeName, Natvis.VisualizerInfo visualizer)
+        {
+            lock (_visualizers)
+            {
+                _visualizers.Set(typeName, visualizer, overwrite: true);
+            }
+        }
 
+        /// <summary>
+        /// Forget the per-type visualizer choices, e.g. because another natvis file was loaded.
+        /// </summary>
+        internal void FlushVisualizers()
+        {
+            lock (_visualizers)
+            {
+                _visualizers.Clear();
+            }
+        }
 
         internal void Flush()
         {
+            string visualizers;
+            lock (_visualizers)
+            {
+                visualizers = _visualizers.ToString();
+            }
             lock (_cache)
             {
+                _logger?.WriteLine(LogLevel.Verbose, "Natvis cache: visualized views: {0}; type visualizers: {1}", _cache, visualizers);
                 _cache.Clear();
             }
         }
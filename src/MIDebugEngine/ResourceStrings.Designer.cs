@@ -355,6 +355,24 @@ namespace Microsoft.MIDebugEngine {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to [{0} lines of program output were dropped].
+        /// </summary>
+        internal static string ProgramOutputDropped {
+            get {
+                return ResourceManager.GetString("ProgramOutputDropped", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to [Unable to write program output to &apos;{0}&apos;: {1}].
+        /// </summary>
+        internal static string ProgramOutputLogFileError {
+            get {
+                return ResourceManager.GetString("ProgramOutputLogFileError", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to [Raw View].
         /// </summary>
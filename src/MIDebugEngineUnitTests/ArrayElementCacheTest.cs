@@ -0,0 +1,96 @@
+using System.Linq;
+using System.Threading.Tasks;
+using Xunit;
+
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class ArrayElementCacheTest
+    {
+        private static string[] Range(uint start, uint end)
+        {
+            return Enumerable.Range((int)start, (int)(end - start)).Select(i => "[" + i + "]").ToArray();
+        }
+
+        [Fact]
+        public void ClampsRangeToArray()
+        {
+            Assert.Equal(10u, ArrayElementCache<string>.ClampCount(0, 10, 100));
+            Assert.Equal(1u, ArrayElementCache<string>.ClampCount(99, 10, 100));    // last element
+            Assert.Equal(0u, ArrayElementCache<string>.ClampCount(100, 10, 100));
+            Assert.Equal(0u, ArrayElementCache<string>.ClampCount(200, 10, 100));
+            Assert.Equal(100u, ArrayElementCache<string>.ClampCount(0, uint.MaxValue, 100));
+        }
+
+        [Fact]
+        public void FetchesFirstAndLastElements()
+        {
+            ArrayElementCache<string> cache = new ArrayElementCache<string>();
+            uint start = 0, end = 1;
+            Assert.True(cache.TrimFetched(ref start, ref end));
+            cache.Add(start, Range(start, end));
+
+            start = 99;
+            end = 100;
+            Assert.True(cache.TrimFetched(ref start, ref end));
+            cache.Add(start, Range(start, end));
+
+            Assert.Equal("[0]", cache.Get(0));
+            Assert.Null(cache.Get(1));
+            Assert.Null(cache.Get(98));
+            Assert.Equal("[99]", cache.Get(99));
+            Assert.Null(cache.Get(100));
+
+            start = 0;
+            end = 100;
+            Assert.True(cache.TrimFetched(ref start, ref end));
+            Assert.Equal(1u, start);
+            Assert.Equal(99u, end);
+        }
+
+        [Fact]
+        public void OverlappingRangesOnlyFetchMissingElements()
+        {
+            ArrayElementCache<string> cache = new ArrayElementCache<string>();
+            cache.Add(10, Range(10, 20));
+
+            // overlaps the start of the fetched range
+            uint start = 5, end = 15;
+            Assert.True(cache.TrimFetched(ref start, ref end));
+            Assert.Equal(5u, start);
+            Assert.Equal(10u, end);
+
+            // overlaps the end of the fetched range
+            start = 15;
+            end = 25;
+            Assert.True(cache.TrimFetched(ref start, ref end));
+            Assert.Equal(20u, start);
+            Assert.Equal(25u, end);
+
+            // within the fetched range
+            start = 12;
+            end = 18;
+            Assert.False(cache.TrimFetched(ref start, ref end));
+        }
+
+        [Fact]
+        public void ConcurrentOverlappingRanges()
+        {
+            ArrayElementCache<string> cache = new ArrayElementCache<string>();
+            Parallel.For(0, 200, i =>
+            {
+                uint start = (uint)(i * 5), end = start + 20;
+                if (cache.TrimFetched(ref start, ref end))
+                {
+                    cache.Add(start, Range(start, end));
+                }
+            });
+
+            for (uint i = 0; i < 1015; i++)
+            {
+                Assert.Equal("[" + i + "]", cache.Get(i));
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+using Xunit;
+
+using MICore;
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class DebuggedModuleTest
+    {
+        [Fact]
+        public void LibraryRangeFromLoadNotification()
+        {
+            Results results = new MIResults(null).ParseResultList(
+                "id=\"/lib/x86_64-linux-gnu/libc.so.6\",target-name=\"/lib/x86_64-linux-gnu/libc.so.6\",host-name=\"/lib/x86_64-linux-gnu/libc.so.6\"," +
+                "symbols-loaded=\"0\",thread-group=\"i1\",ranges=[{from=\"0x00007ffff7dbc700\",to=\"0x00007ffff7f4e93d\"}]");
+
+            Assert.True(DebuggedModule.TryGetLibraryRange(results, out ulong baseAddr, out ulong size));
+            Assert.Equal(0x00007ffff7dbc700UL, baseAddr);
+            Assert.Equal(0x00007ffff7f4e93dUL - 0x00007ffff7dbc700UL, size);
+        }
+
+        [Fact]
+        public void LibraryRangeCoversAllRanges()
+        {
+            Results results = new MIResults(null).ParseResultList(
+                "id=\"a.so\",ranges=[{from=\"0x3000\",to=\"0x4000\"},{from=\"0x1000\",to=\"0x2000\"}]");
+
+            Assert.True(DebuggedModule.TryGetLibraryRange(results, out ulong baseAddr, out ulong size));
+            Assert.Equal(0x1000UL, baseAddr);
+            Assert.Equal(0x3000UL, size);
+        }
+
+        [Fact]
+        public void LibraryWithoutRanges()
+        {
+            Results results = new MIResults(null).ParseResultList("id=\"a.so\",target-name=\"a.so\",host-name=\"a.so\",symbols-loaded=\"0\"");
+
+            Assert.False(DebuggedModule.TryGetLibraryRange(results, out _, out _));
+        }
+    }
+}
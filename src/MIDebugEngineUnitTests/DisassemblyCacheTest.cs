@@ -0,0 +1,89 @@
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class DisassemblyCacheTest
+    {
+        // Instructions of the given length, starting at start
+        private static DisasmInstruction[] Instructions(ulong start, int count, int length = 2)
+        {
+            string codeBytes = string.Join(" ", Enumerable.Repeat("90", length));
+            return Enumerable.Range(0, count)
+                .Select((i) => new DisasmInstruction() { Addr = start + (ulong)(i * length), CodeBytes = codeBytes, Opcode = "nop" })
+                .ToArray();
+        }
+
+        private static List<ulong> Addresses(ICollection<DisasmInstruction> instructions)
+        {
+            return instructions.Select((i) => i.Addr).ToList();
+        }
+
+        [Fact]
+        public void FetchesForwardAndBackward()
+        {
+            DisassemblyCache cache = new DisassemblyCache(1000);
+            cache.Add(Instructions(0x1000, 10));
+
+            Assert.True(cache.TryFetch(0x1004, 3, out ICollection<DisasmInstruction> instructions));
+            Assert.Equal(new List<ulong> { 0x1004, 0x1006, 0x1008 }, Addresses(instructions));
+
+            Assert.True(cache.TryFetch(0x1005, -2, out instructions));   // address within an instruction
+            Assert.Equal(new List<ulong> { 0x1000, 0x1002 }, Addresses(instructions));
+
+            Assert.False(cache.TryFetch(0x1004, -3, out _));
+            Assert.False(cache.TryFetch(0x1010, 3, out _));
+            Assert.False(cache.TryFetch(0x1014, 1, out _));
+        }
+
+        [Fact]
+        public void MergesAdjacentRanges()
+        {
+            DisassemblyCache cache = new DisassemblyCache(1000);
+            cache.Add(Instructions(0x1000, 10));
+            cache.Add(Instructions(0x1028, 10));
+            cache.Add(Instructions(0x1014, 10));
+
+            Assert.Equal(1, cache.BlockCount);
+            Assert.Equal(30, cache.InstructionCount);
+            Assert.True(cache.TryFetch(0x1030, -20, out ICollection<DisasmInstruction> instructions));
+            Assert.Equal(0x1008UL, instructions.First().Addr);
+            Assert.Equal(0x102eUL, instructions.Last().Addr);
+        }
+
+        [Fact]
+        public void NewDecodeReplacesOverlappedInstructions()
+        {
+            DisassemblyCache cache = new DisassemblyCache(1000);
+            cache.Add(Instructions(0x1000, 10));
+            cache.Add(Instructions(0x1005, 2, length: 3));
+
+            Assert.Equal(3, cache.BlockCount);
+            Assert.True(cache.TryFetch(0x1000, 2, out ICollection<DisasmInstruction> instructions));
+            Assert.Equal(new List<ulong> { 0x1000, 0x1002 }, Addresses(instructions));
+            Assert.True(cache.TryFetch(0x1005, 2, out instructions));
+            Assert.Equal(new List<ulong> { 0x1005, 0x1008 }, Addresses(instructions));
+            Assert.False(cache.TryFetch(0x1004, 1, out _));     // straddled the new decode
+            Assert.True(cache.TryFetch(0x100c, 4, out instructions));
+            Assert.Equal(0x1012UL, instructions.Last().Addr);
+        }
+
+        [Fact]
+        public void EvictsLeastRecentlyUsed()
+        {
+            DisassemblyCache cache = new DisassemblyCache(25);
+            cache.Add(Instructions(0x1000, 10));
+            cache.Add(Instructions(0x2000, 10));
+            Assert.True(cache.TryFetch(0x1000, 1, out _));
+            cache.Add(Instructions(0x3000, 10));
+
+            Assert.Equal(20, cache.InstructionCount);
+            Assert.True(cache.TryFetch(0x1000, 1, out _));
+            Assert.False(cache.TryFetch(0x2000, 1, out _));
+            Assert.True(cache.TryFetch(0x3000, 1, out _));
+        }
+    }
+}
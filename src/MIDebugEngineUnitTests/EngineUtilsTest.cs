@@ -0,0 +1,32 @@
+using System;
+using Xunit;
+
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class EngineUtilsTest
+    {
+        [Fact]
+        public void DecodeHexBytes()
+        {
+            byte[] bytes = new byte[6];
+            EngineUtils.DecodeHexBytes("00ff7fA0c3", bytes, 1, 5);
+            Assert.Equal(new byte[] { 0, 0x00, 0xff, 0x7f, 0xa0, 0xc3 }, bytes);
+
+            // Only the requested number of bytes are decoded
+            bytes = new byte[2];
+            EngineUtils.DecodeHexBytes("0102030405", bytes, 0, 2);
+            Assert.Equal(new byte[] { 0x01, 0x02 }, bytes);
+        }
+
+        [Fact]
+        public void DecodeHexBytesInvalid()
+        {
+            byte[] bytes = new byte[2];
+            Assert.Throws<FormatException>(() => EngineUtils.DecodeHexBytes("0g", bytes, 0, 1));
+            Assert.Throws<FormatException>(() => EngineUtils.DecodeHexBytes("é00", bytes, 0, 1));
+            Assert.Throws<ArgumentOutOfRangeException>(() => EngineUtils.DecodeHexBytes("01", bytes, 0, 2));
+        }
+    }
+}
@@ -0,0 +1,42 @@
+using Xunit;
+
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class LogpointTest
+    {
+        [Fact]
+        public void PlainTextIsPrintedWithDprintf()
+        {
+            Logpoint logpoint = Logpoint.Compile(new string[] { "reached 100%" });
+
+            Assert.True(logpoint.IsPlainText);
+            Assert.Equal("reached 100%%\n", logpoint.Format);
+        }
+
+        [Fact]
+        public void KeepsInterpolationsForTheDebugger()
+        {
+            Logpoint logpoint = Logpoint.Compile(new string[] { "x=", "{x}", " in ", "$FUNCTION", " 100%" });
+
+            Assert.False(logpoint.IsPlainText);
+            Assert.Equal(new string[] { "x=", "{x}", " in ", "$FUNCTION", " 100%\n" }, logpoint.Parts);
+        }
+
+        [Fact]
+        public void EndsWithText()
+        {
+            Logpoint logpoint = Logpoint.Compile(new string[] { "", "{f(a, b)}" });
+
+            Assert.Equal(new string[] { "", "{f(a, b)}", "\n" }, logpoint.Parts);
+        }
+
+        [Fact]
+        public void UnsupportedMessagesFallBack()
+        {
+            Assert.Null(Logpoint.Compile(new string[] { "", "$CALLSTACK", "" }));
+            Assert.Null(Logpoint.Compile(new string[0]));
+        }
+    }
+}
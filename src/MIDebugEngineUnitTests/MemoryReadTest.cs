@@ -0,0 +1,48 @@
+using Xunit;
+
+using MICore;
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class MemoryReadTest
+    {
+        private static Results Memory(string begin, string contents)
+        {
+            return new MIResults(null).ParseResultList(
+                "memory=[{begin=\"" + begin + "\",offset=\"0x0000000000000000\",end=\"0x0\",contents=\"" + contents + "\"}]", ResultClass.done);
+        }
+
+        [Fact]
+        public void ReadsAllChunks()
+        {
+            byte[] bytes = new byte[6];
+            Results[] chunks = new Results[] { Memory("0x1000", "01020304"), Memory("0x1004", "0506") };
+
+            Assert.Equal(6u, DebuggedProcess.DecodeMemoryChunks(chunks, 0x1000, 6, 4, bytes));
+            Assert.Equal(new byte[] { 1, 2, 3, 4, 5, 6 }, bytes);
+        }
+
+        [Fact]
+        public void StopsAtUnmappedPage()
+        {
+            // The second chunk starts in an unmapped page, gdb only returns the readable block after it
+            byte[] bytes = new byte[12];
+            Results[] chunks = new Results[] { Memory("0x1ffc", "01020304"), Memory("0x2008", "0909"), Memory("0x2004", "0a0b0c0d") };
+
+            Assert.Equal(4u, DebuggedProcess.DecodeMemoryChunks(chunks, 0x1ffc, 12, 4, bytes));
+            Assert.Equal(new byte[] { 1, 2, 3, 4, 0, 0, 0, 0, 0, 0, 0, 0 }, bytes);
+        }
+
+        [Fact]
+        public void StopsAtFailedOrShortChunk()
+        {
+            byte[] bytes = new byte[12];
+            Results error = new MIResults(null).ParseResultList("msg=\"Unable to read memory.\"", ResultClass.error);
+
+            Assert.Equal(4u, DebuggedProcess.DecodeMemoryChunks(new Results[] { Memory("0x1ffc", "01020304"), error, Memory("0x2004", "05") }, 0x1ffc, 12, 4, bytes));
+            Assert.Equal(6u, DebuggedProcess.DecodeMemoryChunks(new Results[] { Memory("0x1ffc", "01020304"), Memory("0x2000", "0506"), Memory("0x2004", "07") }, 0x1ffc, 12, 4, bytes));
+            Assert.Equal(uint.MaxValue, DebuggedProcess.DecodeMemoryChunks(new Results[] { error, Memory("0x2000", "05") }, 0x1ffc, 8, 4, bytes));
+        }
+    }
+}
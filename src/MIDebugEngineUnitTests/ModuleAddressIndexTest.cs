@@ -0,0 +1,117 @@
+using Xunit;
+
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class ModuleAddressIndexTest
+    {
+        private static DebuggedModule Module(string name, ulong baseAddr, ulong size, uint loadOrder)
+        {
+            return new DebuggedModule(name, name, baseAddr, size, true, name, loadOrder);
+        }
+
+        [Fact]
+        public void FindsModuleContainingAddress()
+        {
+            DebuggedModule a = Module("a.so", 0x1000, 0x1000, 0);
+            DebuggedModule b = Module("b.so", 0x5000, 0x100, 1);
+            DebuggedModule c = Module("c.so", 0x3000, 0x800, 2);
+
+            ModuleAddressIndex index = ModuleAddressIndex.Empty.Add(a).Add(b).Add(c);
+
+            Assert.Null(index.Find(0xfff));
+            Assert.Same(a, index.Find(0x1000));
+            Assert.Same(a, index.Find(0x1fff));
+            Assert.Null(index.Find(0x2000));
+            Assert.Same(c, index.Find(0x3400));
+            Assert.Null(index.Find(0x3800));
+            Assert.Same(b, index.Find(0x50ff));
+            Assert.Null(index.Find(0x5100));
+        }
+
+        [Fact]
+        public void OverlappingModulesResolveToFirstAdded()
+        {
+            DebuggedModule outer = Module("outer.so", 0x1000, 0x10000, 0);
+            DebuggedModule inner = Module("inner.so", 0x2000, 0x100, 1);
+            DebuggedModule later = Module("later.so", 0x3000, 0x100, 2);
+
+            ModuleAddressIndex index = ModuleAddressIndex.Empty.Add(inner).Add(outer).Add(later);
+
+            Assert.Same(outer, index.Find(0x2050));
+            Assert.Same(outer, index.Find(0x3050));
+            Assert.Same(outer, index.Find(0x10fff));
+            Assert.Null(index.Find(0x11000));
+        }
+
+        [Fact]
+        public void PartialOverlapsResolveByLoadOrder()
+        {
+            DebuggedModule a = Module("a.so", 0x1000, 0x2000, 1);
+            DebuggedModule b = Module("b.so", 0x2000, 0x2000, 0);
+            DebuggedModule c = Module("c.so", 0x2800, 0x2800, 2);
+
+            ModuleAddressIndex index = ModuleAddressIndex.Empty.Add(a).Add(b).Add(c);
+
+            Assert.Same(a, index.Find(0x1500));
+            Assert.Same(b, index.Find(0x2500));
+            Assert.Same(b, index.Find(0x3fff));
+            Assert.Same(c, index.Find(0x4000));
+            Assert.Same(c, index.Find(0x4fff));
+            Assert.Null(index.Find(0x5000));
+        }
+
+        [Fact]
+        public void ManyModulesInsideAnEarlyModule()
+        {
+            DebuggedModule outer = Module("outer.so", 0x1000, 0x1000000, 0);
+            ModuleAddressIndex index = ModuleAddressIndex.Empty.Add(outer);
+            DebuggedModule[] inner = new DebuggedModule[1000];
+            for (uint i = 0; i < inner.Length; i++)
+            {
+                inner[i] = Module("inner" + i + ".so", 0x2000 + i * 0x1000, 0x800, i + 1);
+                index = index.Add(inner[i]);
+            }
+
+            Assert.Same(outer, index.Find(0x2400));
+            Assert.Same(outer, index.Find(0x2800));
+            Assert.Null(index.Find(0x1001000));
+
+            ModuleAddressIndex removed = index.Remove(outer);
+            Assert.Same(inner[0], removed.Find(0x2400));
+            Assert.Null(removed.Find(0x2800));
+            Assert.Same(inner[999], removed.Find(0x3e9000));
+        }
+
+        [Fact]
+        public void AddLeavesOriginalIndexUnchanged()
+        {
+            DebuggedModule a = Module("a.so", 0x1000, 0x1000, 0);
+            DebuggedModule empty = Module("empty.so", 0x4000, 0, 1);
+
+            ModuleAddressIndex first = ModuleAddressIndex.Empty.Add(a);
+            ModuleAddressIndex second = first.Add(Module("b.so", 0x8000, 0x1000, 1));
+
+            Assert.Equal(1, first.Count);
+            Assert.Null(first.Find(0x8000));
+            Assert.NotNull(second.Find(0x8000));
+            Assert.Same(first, first.Add(empty));
+        }
+
+        [Fact]
+        public void RemoveDropsOnlyThatModule()
+        {
+            DebuggedModule outer = Module("outer.so", 0x1000, 0x10000, 0);
+            DebuggedModule inner = Module("inner.so", 0x2000, 0x100, 1);
+
+            ModuleAddressIndex index = ModuleAddressIndex.Empty.Add(outer).Add(inner);
+            ModuleAddressIndex removed = index.Remove(outer);
+
+            Assert.Same(inner, removed.Find(0x2050));
+            Assert.Null(removed.Find(0x1000));
+            Assert.Same(outer, index.Find(0x2050));
+            Assert.Same(removed, removed.Remove(outer));
+        }
+    }
+}
@@ -0,0 +1,70 @@
+using System;
+using System.IO;
+using Xunit;
+
+using Microsoft.MIDebugEngine.Natvis;
+
+namespace MIDebugEngineUnitTests
+{
+    public class NatvisFileCacheTest
+    {
+        [Fact]
+        public void ReusesUnchangedFile()
+        {
+            string path = Path.GetTempFileName();
+            try
+            {
+                File.WriteAllText(path, "<AutoVisualizer/>");
+                var cache = new NatvisFileCache<string>();
+                int loads = 0;
+                Func<Stream, string> load = (stream) =>
+                {
+                    loads++;
+                    return new StreamReader(stream).ReadToEnd();
+                };
+
+                Assert.Equal("<AutoVisualizer/>", cache.GetOrLoad(path, load, out bool fromCache));
+                Assert.False(fromCache);
+                Assert.Equal("<AutoVisualizer/>", cache.GetOrLoad(path, load, out fromCache));
+                Assert.True(fromCache);
+                Assert.Equal(1, loads);
+
+                // Same length, different content
+                File.WriteAllText(path, "<AutoVisualizer />");
+                File.SetLastWriteTimeUtc(path, DateTime.UtcNow.AddMinutes(1));
+                Assert.Equal("<AutoVisualizer />", cache.GetOrLoad(path, load, out fromCache));
+                Assert.False(fromCache);
+                Assert.Equal(2, loads);
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+
+        [Fact]
+        public void DoesNotCacheFailedParse()
+        {
+            string path = Path.GetTempFileName();
+            try
+            {
+                var cache = new NatvisFileCache<string>();
+                int loads = 0;
+                Func<Stream, string> load = (stream) =>
+                {
+                    loads++;
+                    return null;
+                };
+
+                Assert.Null(cache.GetOrLoad(path, load, out bool fromCache));
+                Assert.Null(cache.GetOrLoad(path, load, out fromCache));
+                Assert.False(fromCache);
+                Assert.Equal(2, loads);
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }
+    }
+}
@@ -311,6 +311,46 @@ namespace MIDebugEngineUnitTests
             Assert.False(Natvis.IsPrecededByMemberAccessOperator("bar", 0));
         }
 
+        [Fact]
+        public void TypeNameIndex_FindsOnlyCandidatesThatCanMatch()
+        {
+            var vector = TypeName.Parse("std::vector<*>", TestLogger.Instance);
+            var map = TypeName.Parse("std::map<*,*>", TestLogger.Instance);
+            var pairOfInts = TypeName.Parse("std::pair<int,int>", TestLogger.Instance);
+            var pair = TypeName.Parse("std::pair<*,*>", TestLogger.Instance);
+            var foo = TypeName.Parse("Foo", TestLogger.Instance);
+
+            var index = new TypeNameIndex<TypeName>(c => c);
+            foreach (var c in new List<TypeName> { vector, map, pairOfInts, pair, foo })
+            {
+                index.Add(c);
+            }
+
+            Assert.Equal(new List<TypeName> { vector }, index.Find(TypeName.Parse("std::vector<int, std::allocator<int> >", TestLogger.Instance)));
+            Assert.Equal(new List<TypeName> { pairOfInts, pair }, index.Find(TypeName.Parse("std::pair<int,int>", TestLogger.Instance)));
+            Assert.Equal(new List<TypeName> { foo }, index.Find(TypeName.Parse("Foo", TestLogger.Instance)));
+            Assert.Empty(index.Find(TypeName.Parse("Bar", TestLogger.Instance)));
+            Assert.Empty(index.Find(TypeName.Parse("std::vector", TestLogger.Instance)));
+        }
+
+        [Fact]
+        public void TypeNameIndex_KeepsOriginalOrder()
+        {
+            var anyArgs = TypeName.Parse("Foo<*>", TestLogger.Instance);
+            var intArg = TypeName.Parse("Foo<int>", TestLogger.Instance);
+            var anyArg = TypeName.Parse("Foo<*>", TestLogger.Instance);
+
+            var index = new TypeNameIndex<TypeName>(c => c);
+            index.Add(anyArgs);
+            index.Add(intArg);
+            index.Add(anyArg);
+
+            var typeName = TypeName.Parse("Foo<int>", TestLogger.Instance);
+            var candidates = index.Find(typeName);
+            Assert.Equal(new List<TypeName> { anyArgs, intArg, anyArg }, candidates);
+            Assert.Same(intArg, Natvis.FindBestMatch(candidates, typeName, c => c));
+        }
+
         [Fact]
         public void IsPrecededByMemberAccessOperator_NoOperator()
         {
@@ -0,0 +1,42 @@
+using System.Collections.Generic;
+using Xunit;
+
+using Microsoft.MIDebugEngine.Natvis;
+
+namespace MIDebugEngineUnitTests
+{
+    public class NodeWalkerTest
+    {
+        [Fact]
+        public void ParseNodeAddresses()
+        {
+            List<ulong> nodes = NodeWalker.Parse("@natvis-nodes:602010 602030 7ffff7dd0000\n");
+            Assert.Equal(new ulong[] { 0x602010, 0x602030, 0x7ffff7dd0000 }, nodes);
+
+            // Other console output around the result is ignored
+            nodes = NodeWalker.Parse("warning: something\n@natvis-nodes:10 0\n");
+            Assert.Equal(new ulong[] { 0x10, 0 }, nodes);
+
+            nodes = NodeWalker.Parse("@natvis-nodes:");
+            Assert.Empty(nodes);
+        }
+
+        [Fact]
+        public void ParseFailedWalk()
+        {
+            Assert.Null(NodeWalker.Parse(null));
+            Assert.Null(NodeWalker.Parse("Python scripting is not supported in this copy of GDB.\n"));
+            Assert.Null(NodeWalker.Parse("@natvis-nodes:10 zz\n"));
+        }
+
+        [Fact]
+        public void ValueMemberMustBeAMemberName()
+        {
+            Assert.True(NodeWalker.IsValueMember("this"));
+            Assert.True(NodeWalker.IsValueMember("_Myval"));
+            Assert.False(NodeWalker.IsValueMember("value.first"));
+            Assert.False(NodeWalker.IsValueMember("*data"));
+            Assert.False(NodeWalker.IsValueMember(""));
+        }
+    }
+}
@@ -0,0 +1,67 @@
+using System;
+using Xunit;
+
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class PrimitiveFormatterTest
+    {
+        [Fact]
+        public void ClassifiesTypeNames()
+        {
+            Assert.Equal(PrimitiveKind.Signed, PrimitiveFormatter.GetKind("int"));
+            Assert.Equal(PrimitiveKind.Signed, PrimitiveFormatter.GetKind("const long"));
+            Assert.Equal(PrimitiveKind.Unsigned, PrimitiveFormatter.GetKind("unsigned long long"));
+            Assert.Equal(PrimitiveKind.Char, PrimitiveFormatter.GetKind("char"));
+            Assert.Equal(PrimitiveKind.UnsignedChar, PrimitiveFormatter.GetKind("uint8_t"));
+            Assert.Equal(PrimitiveKind.Float, PrimitiveFormatter.GetKind("volatile double"));
+            Assert.Equal(PrimitiveKind.None, PrimitiveFormatter.GetKind("int *"));
+            Assert.Equal(PrimitiveKind.None, PrimitiveFormatter.GetKind("long double"));
+            Assert.Equal(PrimitiveKind.None, PrimitiveFormatter.GetKind("MyStruct"));
+        }
+
+        [Fact]
+        public void FormatsIntegers()
+        {
+            byte[] bytes = new byte[12];
+            Buffer.BlockCopy(new int[] { 42, -1, 0 }, 0, bytes, 0, bytes.Length);
+
+            Assert.Equal(new string[] { "42", "-1", "0" }, PrimitiveFormatter.Format(bytes, 3, PrimitiveKind.Signed, 4, 10, null));
+            Assert.Equal(new string[] { "42", "4294967295", "0" }, PrimitiveFormatter.Format(bytes, 3, PrimitiveKind.Unsigned, 4, 10, null));
+            Assert.Equal(new string[] { "0x2a", "0xffffffff", "0x0" }, PrimitiveFormatter.Format(bytes, 3, PrimitiveKind.Signed, 4, 16, null));
+            Assert.Equal(new string[] { "0x0000002a", "0xffffffff", "0x00000000" }, PrimitiveFormatter.Format(bytes, 3, PrimitiveKind.Signed, 4, 10, "zero-hexadecimal"));
+            Assert.Equal(new string[] { "052", "037777777777", "0" }, PrimitiveFormatter.Format(bytes, 3, PrimitiveKind.Signed, 4, 10, "octal"));
+            Assert.Equal(new string[] { "101010" }, PrimitiveFormatter.Format(bytes, 1, PrimitiveKind.Signed, 4, 10, "binary"));
+            Assert.Equal(new string[] { "42", "-1", "0" }, PrimitiveFormatter.Format(bytes, 3, PrimitiveKind.Signed, 4, 10, "natural"));
+            Assert.Equal(new string[] { "0x2a", "0xffffffff", "0x0" }, PrimitiveFormatter.Format(bytes, 3, PrimitiveKind.Signed, 4, 16, "natural"));
+        }
+
+        [Fact]
+        public void FormatsCharactersLikeGdb()
+        {
+            byte[] bytes = new byte[] { (byte)'a', 0, (byte)'\n', 0xff, (byte)'\'' };
+
+            Assert.Equal(new string[] { "97 'a'", "0 '\\000'", "10 '\\n'", "-1 '\\377'", "39 '\\''" },
+                PrimitiveFormatter.Format(bytes, 5, PrimitiveKind.SignedChar, 1, 10, null));
+            Assert.Equal(new string[] { "0x61 'a'", "0x0 '\\000'", "0xa '\\n'", "0xff '\\377'", "0x27 '\\''" },
+                PrimitiveFormatter.Format(bytes, 5, PrimitiveKind.UnsignedChar, 1, 16, null));
+            Assert.Equal(new string[] { "0x61 'a'" }, PrimitiveFormatter.Format(bytes, 1, PrimitiveKind.SignedChar, 1, 16, "natural"));
+            Assert.Null(PrimitiveFormatter.Format(bytes, 5, PrimitiveKind.Char, 1, 10, null));
+        }
+
+        [Fact]
+        public void FormatsFloatingPointLikeGdb()
+        {
+            byte[] doubles = new byte[48];
+            Buffer.BlockCopy(new double[] { 0.1, 3.0, 1e20, -0.0, double.NegativeInfinity, double.NaN }, 0, doubles, 0, doubles.Length);
+            byte[] floats = new byte[8];
+            Buffer.BlockCopy(new float[] { 0.1f, 1.5f }, 0, floats, 0, floats.Length);
+
+            Assert.Equal(new string[] { "0.10000000000000001", "3", "1e+20", "-0", "-inf", "-nan(0x8000000000000)" },
+                PrimitiveFormatter.Format(doubles, 6, PrimitiveKind.Float, 8, 16, null));
+            Assert.Equal(new string[] { "0.100000001", "1.5" }, PrimitiveFormatter.Format(floats, 2, PrimitiveKind.Float, 4, 10, null));
+            Assert.Null(PrimitiveFormatter.Format(floats, 2, PrimitiveKind.Float, 4, 10, "zero-hexadecimal"));
+        }
+    }
+}
@@ -0,0 +1,94 @@
+using System.Collections.Generic;
+using System.Globalization;
+using System.Threading;
+using Xunit;
+
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class ProgramOutputBufferTest
+    {
+        private readonly List<string> _sent = new List<string>();
+        private int _now;
+
+        private ProgramOutputBuffer CreateBuffer(int maxLinesPerSecond)
+        {
+            return new ProgramOutputBuffer(s => _sent.Add(s), maxLinesPerSecond, null, null, Timeout.Infinite, () => _now);
+        }
+
+        private static string Dropped(int lines)
+        {
+            return string.Format(CultureInfo.CurrentCulture, ResourceStrings.ProgramOutputDropped, lines) + "\n";
+        }
+
+        [Fact]
+        public void OutputIsBatchedUntilFlushed()
+        {
+            ProgramOutputBuffer buffer = CreateBuffer(0);
+            buffer.Write("one\n", isProgramOutput: true);
+            buffer.Write("two\n", isProgramOutput: false);
+            Assert.Empty(_sent);
+
+            buffer.Flush();
+            Assert.Equal(new string[] { "one\ntwo\n" }, _sent);
+
+            buffer.Close();
+            buffer.Write("three\n", isProgramOutput: true);
+            Assert.Equal(new string[] { "one\ntwo\n", "three\n" }, _sent);
+        }
+
+        [Fact]
+        public void OnlyProgramOutputIsDropped()
+        {
+            ProgramOutputBuffer buffer = CreateBuffer(2);
+            buffer.Write("a\nb\n", isProgramOutput: true);
+            buffer.Write("c\n", isProgramOutput: true);
+            buffer.Write("d\ne\n", isProgramOutput: true);
+            buffer.Write("debugger\n", isProgramOutput: false);
+            buffer.Flush();
+
+            Assert.Equal(new string[] { "a\nb\ndebugger\n" + Dropped(3) }, _sent);
+            buffer.Close();
+        }
+
+        [Fact]
+        public void RateWindowRollsOver()
+        {
+            ProgramOutputBuffer buffer = CreateBuffer(1);
+            buffer.Write("a\n", isProgramOutput: true);
+            buffer.Write("b\n", isProgramOutput: true);
+
+            _now += 1000;
+            buffer.Write("c\n", isProgramOutput: true);
+            buffer.Write("d\n", isProgramOutput: true);
+
+            _now += 999;
+            buffer.Write("e\n", isProgramOutput: true);
+            buffer.Flush();
+
+            Assert.Equal(new string[] { "a\n" + Dropped(1) + "c\n" + Dropped(2) }, _sent);
+            buffer.Close();
+        }
+
+        [Fact]
+        public void NothingIsDroppedWithoutALimit()
+        {
+            ProgramOutputBuffer buffer = CreateBuffer(0);
+            string line = new string('x', 1023) + "\n";
+            int count = 5 * 1024;
+            for (int i = 0; i < count; i++)
+            {
+                buffer.Write(line, isProgramOutput: true);
+            }
+            buffer.Close();
+
+            int length = 0;
+            foreach (string chunk in _sent)
+            {
+                length += chunk.Length;
+            }
+            Assert.Equal(count * line.Length, length);
+        }
+    }
+}
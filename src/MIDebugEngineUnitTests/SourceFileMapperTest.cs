@@ -0,0 +1,73 @@
+using System.Collections.Generic;
+using System.IO;
+using Xunit;
+
+using MICore;
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class SourceFileMapperTest
+    {
+        private static SourceMapEntry Entry(string editorPath, string compileTimePath, bool useForBreakpoints = true)
+        {
+            return new SourceMapEntry() { EditorPath = editorPath, CompileTimePath = compileTimePath, UseForBreakpoints = useForBreakpoints };
+        }
+
+        [Fact]
+        public void MapsAtDirectoryBoundaries()
+        {
+            SourceFileMapper mapper = new SourceFileMapper(new List<SourceMapEntry>()
+            {
+                Entry("/home/me/src", "/build/src"),
+                Entry("/home/me/lib/", "/build/lib/"),
+            }, editorPathsIgnoreCase: false, compileTimePathsIgnoreCase: false);
+
+            Assert.True(mapper.MapCurrentToCompileTime("/home/me/src/a/b.c", out string compilerSrc));
+            Assert.Equal("/build/src/a/b.c", compilerSrc);
+            Assert.True(mapper.MapCurrentToCompileTime("/home/me/lib/c.c", out compilerSrc));
+            Assert.Equal("/build/lib/c.c", compilerSrc);
+            Assert.False(mapper.MapCurrentToCompileTime("/home/me/srcx/a.c", out compilerSrc));
+            Assert.Equal("/home/me/srcx/a.c", compilerSrc);
+
+            Assert.True(mapper.MapCompileTimeToCurrent("/build/src/a/b.c", out string currentName));
+            Assert.Equal(Path.Combine("/home/me/src", "a/b.c"), currentName);
+            Assert.False(mapper.MapCompileTimeToCurrent("/build/srcx/a.c", out _));
+            Assert.False(mapper.MapCompileTimeToCurrent("/build/lib/", out _));
+        }
+
+        [Fact]
+        public void FirstMatchingEntryWins()
+        {
+            SourceFileMapper mapper = new SourceFileMapper(new List<SourceMapEntry>()
+            {
+                Entry("/home/me/src", "/build/src"),
+                Entry("/home/me/src/generated", "/gen"),
+                Entry("/home/me/other", "/build/src/special"),
+            }, editorPathsIgnoreCase: false, compileTimePathsIgnoreCase: false);
+
+            Assert.True(mapper.MapCurrentToCompileTime("/home/me/src/generated/g.c", out string compilerSrc));
+            Assert.Equal("/build/src/generated/g.c", compilerSrc);
+            Assert.True(mapper.MapCompileTimeToCurrent("/gen/g.c", out string currentName));
+            Assert.Equal(Path.Combine("/home/me/src/generated", "g.c"), currentName);
+            Assert.True(mapper.MapCompileTimeToCurrent("/build/src/special/s.c", out currentName));
+            Assert.Equal(Path.Combine("/home/me/src", "special/s.c"), currentName);
+        }
+
+        [Fact]
+        public void HonorsCaseSensitivityAndBreakpointFlag()
+        {
+            SourceFileMapper mapper = new SourceFileMapper(new List<SourceMapEntry>()
+            {
+                Entry("/Home/Me/Src", "/build/src"),
+                Entry("/home/me/nobp", "/build/nobp", useForBreakpoints: false),
+            }, editorPathsIgnoreCase: true, compileTimePathsIgnoreCase: false);
+
+            Assert.True(mapper.MapCurrentToCompileTime("/home/me/src/a.c", out string compilerSrc));
+            Assert.Equal("/build/src/a.c", compilerSrc);
+            Assert.False(mapper.MapCompileTimeToCurrent("/BUILD/src/a.c", out _));
+            Assert.False(mapper.MapCurrentToCompileTime("/home/me/nobp/a.c", out _));
+            Assert.True(mapper.MapCompileTimeToCurrent("/build/nobp/a.c", out _));
+        }
+    }
+}
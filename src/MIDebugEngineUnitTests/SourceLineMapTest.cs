@@ -0,0 +1,49 @@
+using System.Collections.Generic;
+using Xunit;
+
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class SourceLineMapTest
+    {
+        [Fact]
+        public void LooksUpLineByStartAddress()
+        {
+            SourceLineMap map = new SourceLineMap(
+                new ulong[] { 0x1010, 0x1000, 0x1020, 0x1000 },
+                new uint[] { 11, 0, 12, 10 });
+
+            Assert.Equal(3, map.Count);
+            Assert.True(map.TryGetLine(0x1000, out uint line));
+            Assert.Equal(10u, line);    // non-zero line preferred for a duplicate address
+            Assert.True(map.TryGetLine(0x1020, out line));
+            Assert.Equal(12u, line);
+            Assert.False(map.TryGetLine(0x1018, out _));
+        }
+
+        [Fact]
+        public void StartAddressesForLineOncePerFunction()
+        {
+            // Two functions with code for line 5, separated by an end of function marker
+            SourceLineMap map = new SourceLineMap(
+                new ulong[] { 0x100, 0x108, 0x110, 0x118, 0x200, 0x208, 0x210 },
+                new uint[] { 5, 6, 5, 0, 4, 5, 0 });
+
+            Assert.Equal(new List<ulong> { 0x100, 0x208 }, map.StartAddressesForLine(5));
+            Assert.Equal(new List<ulong> { 0x200 }, map.StartAddressesForLine(4));
+            Assert.Empty(map.StartAddressesForLine(7));
+        }
+
+        [Fact]
+        public void ContainsAddressInRange()
+        {
+            SourceLineMap map = new SourceLineMap(new ulong[] { 0x1000, 0x3000 }, new uint[] { 1, 2 });
+
+            Assert.True(map.ContainsAddressIn(0x0, 0x1001));
+            Assert.False(map.ContainsAddressIn(0x1001, 0x3000));
+            Assert.True(map.ContainsAddressIn(0x2000, 0x4000));
+            Assert.False(SourceLineMap.Empty.ContainsAddressIn(0, ulong.MaxValue));
+        }
+    }
+}
@@ -0,0 +1,98 @@
+using System.Collections.Generic;
+using Xunit;
+
+using MICore;
+using Microsoft.MIDebugEngine;
+
+namespace MIDebugEngineUnitTests
+{
+    public class VariableObjectPoolTest
+    {
+        private static VariableObjectPool.Key Key(string expression, string frame = "fact@0x7ffe0100")
+        {
+            return new VariableObjectPool.Key(expression, 1, frame, 0, 10);
+        }
+
+        [Fact]
+        public void ReleasedObjectIsTakenOnce()
+        {
+            VariableObjectPool pool = new VariableObjectPool();
+            pool.OnBreak();
+            Assert.Null(pool.Release(Key("x"), new VariableObjectPool.Entry() { Name = "var1" }));
+
+            Assert.Null(pool.Take(Key("x", frame: "main@0x7ffe0200")));
+            Assert.Equal("var1", pool.Take(Key("x")).Name);
+            Assert.Null(pool.Take(Key("x")));
+        }
+
+        [Fact]
+        public void ObjectIsOnlyTakenInTheSameCall()
+        {
+            VariableObjectPool pool = new VariableObjectPool();
+            pool.OnBreak();
+            pool.Release(Key("n"), new VariableObjectPool.Entry() { Name = "var1" });
+
+            // stepped into a recursive call: level 0 is now a new frame of the same function, and the caller's object
+            // is taken for its locals one level up
+            pool.OnBreak();
+            Assert.Null(pool.Take(Key("n", frame: "fact@0x7ffe00c0")));
+            Assert.Equal("var1", pool.Take(Key("n", frame: "fact@0x7ffe0100")).Name);
+        }
+
+        [Fact]
+        public void ReleasingSameKeyDisplacesEarlierObject()
+        {
+            VariableObjectPool pool = new VariableObjectPool();
+            pool.Release(Key("x"), new VariableObjectPool.Entry() { Name = "var1" });
+
+            Assert.Equal("var1", pool.Release(Key("x"), new VariableObjectPool.Entry() { Name = "var2" }));
+            Assert.Equal(1, pool.Count);
+        }
+
+        [Fact]
+        public void ExpiresObjectsNotReusedForABreak()
+        {
+            VariableObjectPool pool = new VariableObjectPool();
+
+            // released at the first stop
+            pool.OnBreak();
+            pool.Release(Key("a"), new VariableObjectPool.Entry() { Name = "var1" });
+            pool.Release(Key("b"), new VariableObjectPool.Entry() { Name = "var2" });
+            Assert.Empty(pool.Expire());
+
+            // "a" is evaluated again during the next break, "b" isn't
+            VariableObjectPool.Entry a = pool.Take(Key("a"));
+            pool.OnBreak();
+            pool.Release(Key("a"), a);
+
+            Assert.Equal(new List<string> { "var2" }, pool.Expire());
+            Assert.Equal(1, pool.Count);
+        }
+
+        [Fact]
+        public void UpdateAppliesChangelist()
+        {
+            VariableObjectPool pool = new VariableObjectPool();
+            pool.OnBreak();
+            pool.Release(Key("a"), new VariableObjectPool.Entry() { Name = "var1", Value = "1" });
+            pool.Release(Key("b"), new VariableObjectPool.Entry() { Name = "var2", Value = "2" });
+            pool.Release(Key("c"), new VariableObjectPool.Entry() { Name = "var3", Value = "3" });
+            pool.OnBreak();
+            Assert.True(pool.NeedsUpdate);
+
+            Results results = new MIResults(null).ParseResultList(
+                "changelist=[{name=\"var1\",value=\"5\",in_scope=\"true\",type_changed=\"false\",has_more=\"0\"}," +
+                "{name=\"var1.x\",value=\"7\",in_scope=\"true\",type_changed=\"false\",has_more=\"0\"}," +
+                "{name=\"var2\",in_scope=\"false\",has_more=\"0\"}]");
+            List<string> removed = pool.Update(results.Find<ValueListValue>("changelist").AsArray<TupleValue>());
+
+            Assert.Equal(new List<string> { "var2" }, removed);
+            Assert.False(pool.NeedsUpdate);
+            VariableObjectPool.Entry a = pool.Take(Key("a"));
+            Assert.True(a.Updated);
+            Assert.Equal("5", a.Value);
+            Assert.Null(pool.Take(Key("b")));
+            Assert.Equal("3", pool.Take(Key("c")).Value);
+        }
+    }
+}
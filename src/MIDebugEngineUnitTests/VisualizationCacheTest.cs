@@ -0,0 +1,42 @@
+using Xunit;
+
+using Microsoft.MIDebugEngine.Natvis;
+
+namespace MIDebugEngineUnitTests
+{
+    public class VisualizationCacheTest
+    {
+        [Fact]
+        public void VisualizerLookupEvictsLeastRecentlyUsed()
+        {
+            VisualizationCache cache = new VisualizationCache();
+            int capacity = 4096;
+            for (int i = 0; i < capacity; i++)
+            {
+                cache.AddVisualizer("T" + i, null);
+            }
+
+            // Touch the oldest entry so the next one is evicted instead
+            Assert.True(cache.TryGetVisualizer("T0", out _));
+            cache.AddVisualizer("T" + capacity, null);
+
+            Assert.True(cache.TryGetVisualizer("T0", out _));
+            Assert.False(cache.TryGetVisualizer("T1", out _));
+            Assert.True(cache.TryGetVisualizer("T2", out _));
+            Assert.True(cache.TryGetVisualizer("T" + capacity, out _));
+        }
+
+        [Fact]
+        public void VisualizerLookupSurvivesBreakStateFlush()
+        {
+            VisualizationCache cache = new VisualizationCache();
+            cache.AddVisualizer("std::vector<int>", null);
+
+            cache.Flush();
+            Assert.True(cache.TryGetVisualizer("std::vector<int>", out _));
+
+            cache.FlushVisualizers();
+            Assert.False(cache.TryGetVisualizer("std::vector<int>", out _));
+        }
+    }
+}
@@ -1797,53 +1797,79 @@ namespace OpenDebugAD7
                 }
 
                 ErrorBuilder eb = new ErrorBuilder(() => AD7Resources.Error_Scenario_StackTrace);
+                FRAMEINFO[] frameInfoArray;
+                uint framesFetched = 0;
+                uint totalFrames;
 
-                try
+                if (thread is IDebugThreadDAP threadDAP)
                 {
-                    eb.CheckHR(thread.EnumFrameInfo(flags, radix, out IEnumDebugFrameInfo2 frameEnum));
-                    eb.CheckHR(frameEnum.GetCount(out uint totalFrames));
+                    // Only walk the part of the stack that was asked for
+                    IEnumDebugFrameInfo2 frameEnum;
+                    try
+                    {
+                        eb.CheckHR(threadDAP.EnumFrameInfoRange(flags, radix, (uint)startFrame, (uint)levels, out frameEnum, out totalFrames));
+                        eb.CheckHR(frameEnum.GetCount(out uint count));
+                        frameInfoArray = new FRAMEINFO[count];
+                    }
+                    catch (AD7Exception ex)
+                    {
+                        responder.SetError(new ProtocolException(ex.Message, ex));
+                        return;
+                    }
 
-                    frameEnumInfo = new ThreadFrameEnumInfo(frameEnum, totalFrames);
+                    if (frameInfoArray.Length > 0)
+                    {
+                        frameEnum.Next((uint)frameInfoArray.Length, frameInfoArray, ref framesFetched);
+                    }
                 }
-                catch (AD7Exception ex)
+                else
                 {
-                    responder.SetError(new ProtocolException(ex.Message, ex));
-                    return;
-                }
+                    try
+                    {
+                        eb.CheckHR(thread.EnumFrameInfo(flags, radix, out IEnumDebugFrameInfo2 frameEnum));
+                        eb.CheckHR(frameEnum.GetCount(out uint frameCount));
 
+                        frameEnumInfo = new ThreadFrameEnumInfo(frameEnum, frameCount);
+                    }
+                    catch (AD7Exception ex)
+                    {
+                        responder.SetError(new ProtocolException(ex.Message, ex));
+                        return;
+                    }
 
-                if (startFrame >= frameEnumInfo.TotalFrames)
-                {
-                    responder.SetResponse(response);
-                    return;
-                }
+                    if (startFrame >= frameEnumInfo.TotalFrames)
+                    {
+                        responder.SetResponse(response);
+                        return;
+                    }
 
-                if (startFrame != frameEnumInfo.CurrentPosition)
-                {
-                    frameEnumInfo.FrameEnum.Reset();
-                    frameEnumInfo.CurrentPosition = (uint)startFrame;
+                    if (startFrame != frameEnumInfo.CurrentPosition)
+                    {
+                        frameEnumInfo.FrameEnum.Reset();
+                        frameEnumInfo.CurrentPosition = (uint)startFrame;
 
-                    if (startFrame > 0)
+                        if (startFrame > 0)
+                        {
+                            frameEnumInfo.FrameEnum.Skip((uint)startFrame);
+                        }
+                    }
+
+                    if (levels == 0)
                     {
-                        frameEnumInfo.FrameEnum.Skip((uint)startFrame);
+                        // take the rest of the stack frames
+                        levels = (int)frameEnumInfo.TotalFrames - startFrame;
+                    }
+                    else
+                    {
+                        levels = Math.Min((int)frameEnumInfo.TotalFrames - startFrame, levels);
                     }
-                }
 
-                if (levels == 0)
-                {
-                    // take the rest of the stack frames
-                    levels = (int)frameEnumInfo.TotalFrames - startFrame;
-                }
-                else
-                {
-                    levels = Math.Min((int)frameEnumInfo.TotalFrames - startFrame, levels);
+                    frameInfoArray = new FRAMEINFO[levels];
+                    frameEnumInfo.FrameEnum.Next((uint)frameInfoArray.Length, frameInfoArray, ref framesFetched);
+                    frameEnumInfo.CurrentPosition += framesFetched;
+                    totalFrames = frameEnumInfo.TotalFrames;
                 }
 
-                var frameInfoArray = new FRAMEINFO[levels];
-                uint framesFetched = 0;
-                frameEnumInfo.FrameEnum.Next((uint)frameInfoArray.Length, frameInfoArray, ref framesFetched);
-                frameEnumInfo.CurrentPosition += framesFetched;
-
                 for (int i = 0; i < framesFetched; i++)
                 {
                     // TODO: annotated frames?
@@ -1928,7 +1954,7 @@ namespace OpenDebugAD7
                     }
                 }
 
-                response.TotalFrames = (int)frameEnumInfo.TotalFrames;
+                response.TotalFrames = (int)totalFrames;
 
                 responder.SetResponse(response);
             }
@@ -2014,7 +2040,29 @@ namespace OpenDebugAD7
 
             Guid empty = Guid.Empty;
             IDebugProperty2 property = variableEvaluationData.DebugProperty;
-            if (property.EnumChildren(variableEvaluationData.propertyInfoFlags, radix, ref empty, enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_ALL, null, Constants.EvaluationTimeout, out IEnumDebugPropertyInfo2 childEnum) == 0)
+            IEnumDebugPropertyInfo2 childEnum;
+            int hr;
+            uint indexedCount = 0;
+            bool isPaged = responder.Arguments.Filter.HasValue || responder.Arguments.Start.HasValue || responder.Arguments.Count.HasValue;
+            if (isPaged && property is IDebugPropertyDAP indexedProperty && indexedProperty.GetIndexedChildCount(out indexedCount) == HRConstants.S_OK)
+            {
+                if (responder.Arguments.Filter == VariablesArguments.FilterValue.Named)
+                {
+                    // Array elements are all indexed
+                    responder.SetResponse(response);
+                    return;
+                }
+
+                // Only fetch the page of elements the client asked for, a missing or zero count means the rest of the array
+                uint start = (uint)responder.Arguments.Start.GetValueOrDefault(0);
+                uint count = responder.Arguments.Count.GetValueOrDefault(0) > 0 ? (uint)responder.Arguments.Count.Value : indexedCount;
+                hr = indexedProperty.EnumChildrenRange(variableEvaluationData.propertyInfoFlags, radix, start, count, Constants.EvaluationTimeout, out childEnum);
+            }
+            else
+            {
+                hr = property.EnumChildren(variableEvaluationData.propertyInfoFlags, radix, ref empty, enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_ALL, null, Constants.EvaluationTimeout, out childEnum);
+            }
+            if (hr == 0)
             {
                 uint count;
                 childEnum.GetCount(out count);
@@ -4,11 +4,12 @@
 using System;
 using Microsoft.DebugEngineHost;
 using Microsoft.VisualStudio.Debugger.Interop;
+using Microsoft.VisualStudio.Debugger.Interop.DAP;
 using Microsoft.VisualStudio.Shared.VSCodeDebugProtocol.Messages;
 
 namespace OpenDebugAD7.AD7Impl
 {
-    internal sealed class AD7BreakPointRequest : IDebugBreakpointRequest2, IDebugBreakpointChecksumRequest2
+    internal sealed class AD7BreakPointRequest : IDebugBreakpointRequest2, IDebugBreakpointChecksumRequest2, IDebugBreakpointRequestDAP
     {
         private static uint s_nextBreakpointId = 0;
 
@@ -193,6 +194,17 @@ namespace OpenDebugAD7.AD7Impl
 
         public Tracepoint Tracepoint => m_Tracepoint;
 
+        public int GetLogMessage(out string[] parts)
+        {
+            if (!HasTracepoint)
+            {
+                parts = null;
+                return HRConstants.S_FALSE;
+            }
+            parts = m_Tracepoint.GetLogMessageParts();
+            return HRConstants.S_OK;
+        }
+
         #endregion
 
         #region Hit Conditions
@@ -228,6 +240,11 @@ namespace OpenDebugAD7.AD7Impl
                 style = enum_BP_PASSCOUNT_STYLE.BP_PASSCOUNT_EQUAL_OR_GREATER;
                 numberPart = hc.Substring(2).Trim();
             }
+            else if (hc.StartsWith("=="))
+            {
+                style = enum_BP_PASSCOUNT_STYLE.BP_PASSCOUNT_EQUAL;
+                numberPart = hc.Substring(2).Trim();
+            }
             else if (hc.StartsWith("%"))
             {
                 style = enum_BP_PASSCOUNT_STYLE.BP_PASSCOUNT_MOD;
@@ -30,6 +30,7 @@ namespace OpenDebug
             bool enableEngineLogger = false;
             LogLevel level = LogLevel.Verbose;
             string logFilePath = string.Empty;
+            long logFileMaxSize = 0;
 
             // parse command line arguments
             foreach (var a in argv)
@@ -52,6 +53,8 @@ namespace OpenDebug
                         Console.WriteLine("--trace=response: print requests and response from VS Code to the console.");
                         Console.WriteLine("--engineLogging[=filePath]: Enable logging from the debug engine. If not");
                         Console.WriteLine("    specified, the log will go to the console.");
+                        Console.WriteLine("--engineLogMaxSize=<MB>: When logging to a file, start a new file once it");
+                        Console.WriteLine("    reaches this size. The previous file is kept as <filePath>.1");
                         Console.WriteLine("--engineLogLevel=<LogLevel>: Set's the log level for engine logging.");
                         Console.WriteLine("    If not specified, default log level is LogLevel.Verbose");
                         Console.WriteLine("--natvisDiagnostics[=logLevel]: Enable logging for natvis. If not");
@@ -115,7 +118,16 @@ namespace OpenDebug
                         {
                             enableEngineLogger = true;
                             logFilePath = a.Substring("--engineLogging=".Length);
-                            HostLogger.SetEngineLogFile(logFilePath);
+                        }
+                        else if (a.StartsWith("--engineLogMaxSize=", StringComparison.Ordinal))
+                        {
+                            string sizeString = a.Substring("--engineLogMaxSize=".Length);
+                            if (!long.TryParse(sizeString, out logFileMaxSize) || logFileMaxSize < 0)
+                            {
+                                Console.Error.WriteLine("OpenDebugAD7: ERROR: Unable to parse log file size '{0}'.", sizeString);
+                                return -1;
+                            }
+                            logFileMaxSize *= 1024 * 1024;
                         }
                         else if (a.StartsWith("--engineLogLevel=", StringComparison.Ordinal))
                         {
@@ -145,6 +157,11 @@ namespace OpenDebug
 
             if (enableEngineLogger)
             {
+                if (!string.IsNullOrEmpty(logFilePath))
+                {
+                    HostLogger.SetEngineLogFile(logFilePath, logFileMaxSize);
+                }
+
                 loggingCategories.Add(LoggingCategory.EngineLogging);
                 try
                 {
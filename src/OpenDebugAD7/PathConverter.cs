@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project root for full license information.
 
 using System;
+using System.Collections.Generic;
 using System.IO;
 using OpenDebug;
 
@@ -11,8 +12,24 @@ namespace OpenDebugAD7
     {
         internal bool DebuggerLinesStartAt1 { get; set; }
         internal bool ClientLinesStartAt1 { get; set; }
-        internal bool DebuggerPathsAreURI { get; set; }
-        internal bool ClientPathsAreURI { get; set; }
+        internal bool DebuggerPathsAreURI
+        {
+            get { return _debuggerPathsAreURI; }
+            set { _debuggerPathsAreURI = value; ClearConvertedPaths(); }
+        }
+        internal bool ClientPathsAreURI
+        {
+            get { return _clientPathsAreURI; }
+            set { _clientPathsAreURI = value; ClearConvertedPaths(); }
+        }
+
+        private bool _debuggerPathsAreURI;
+        private bool _clientPathsAreURI;
+
+        // Converting a path normalizes it, which looks up the casing of each directory on disk on Windows and OSX,
+        // and the same few paths are converted for every stack frame.
+        private const int MaxConvertedPaths = 4096;
+        private readonly Dictionary<string, string> _debuggerToClientPaths = new Dictionary<string, string>(StringComparer.Ordinal);
 
         internal PathConverter()
         {
@@ -51,6 +68,36 @@ namespace OpenDebugAD7
         }
 
         internal string ConvertDebuggerPathToClient(string path)
+        {
+            lock (_debuggerToClientPaths)
+            {
+                if (_debuggerToClientPaths.TryGetValue(path, out string clientPath))
+                {
+                    return clientPath;
+                }
+            }
+
+            string converted = ConvertDebuggerPathToClientUncached(path);
+            lock (_debuggerToClientPaths)
+            {
+                if (_debuggerToClientPaths.Count >= MaxConvertedPaths)
+                {
+                    _debuggerToClientPaths.Clear();
+                }
+                _debuggerToClientPaths[path] = converted;
+            }
+            return converted;
+        }
+
+        private void ClearConvertedPaths()
+        {
+            lock (_debuggerToClientPaths)
+            {
+                _debuggerToClientPaths.Clear();
+            }
+        }
+
+        private string ConvertDebuggerPathToClientUncached(string path)
         {
             if (Path.DirectorySeparatorChar == '/')
             {
@@ -44,6 +44,23 @@ namespace OpenDebugAD7
             return hr;
         }
 
+        /// <summary>
+        /// Splits the parsed message into alternating literal text and interpolations, starting and ending with text.
+        /// </summary>
+        internal string[] GetLogMessageParts()
+        {
+            List<string> parts = new List<string>();
+            int currIndex = 0;
+            foreach (KeyValuePair<int, string> keyValuePair in m_indexToExpressions)
+            {
+                parts.Add(LogMessage.Substring(currIndex, keyValuePair.Key - currIndex));
+                parts.Add(keyValuePair.Value);
+                currIndex = keyValuePair.Key + keyValuePair.Value.Length;
+            }
+            parts.Add(LogMessage.Substring(currIndex));
+            return parts.ToArray();
+        }
+
         private int GetInterpolatedLogMessage(string logMessage, IDebugThread2 pThread, uint radix, string processName, int processId, out string message)
         {
             int hr = HRConstants.S_OK;
@@ -5,6 +5,7 @@ using System;
 using System.Collections.Generic;
 using Microsoft.DebugEngineHost.VSCode;
 using Microsoft.VisualStudio.Debugger.Interop;
+using Microsoft.VisualStudio.Debugger.Interop.DAP;
 using Microsoft.VisualStudio.Shared.VSCodeDebugProtocol.Messages;
 
 namespace OpenDebugAD7
@@ -107,6 +108,10 @@ namespace OpenDebugAD7
                 MemoryReference = memoryReference
             };
 
+            // Arrays report their length so the client can page through the elements instead of fetching them all
+            if (handle != 0 && propertyInfo.pProperty is IDebugPropertyDAP indexedProperty && indexedProperty.GetIndexedChildCount(out uint indexedCount) == HRConstants.S_OK)
+                v.IndexedVariables = (int)indexedCount;
+
             if (propertyInfo.dwAttrib.HasFlag(enum_DBG_ATTRIB_FLAGS.DBG_ATTRIB_VALUE_READONLY))
                 v.PresentationHint = new VariablePresentationHint() { Attributes = VariablePresentationHint.AttributesValue.ReadOnly };
 
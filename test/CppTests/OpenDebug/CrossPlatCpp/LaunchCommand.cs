@@ -46,6 +46,9 @@ namespace DebuggerTesting.OpenDebug.CrossPlatCpp
 
         [JsonProperty(DefaultValueHandling = DefaultValueHandling.Ignore)]
         public SetupCommandArg[] setupCommands;
+
+        [JsonProperty(DefaultValueHandling = DefaultValueHandling.Ignore)]
+        public SymbolLoadInfoArgs symbolLoadInfo;
     }
 
     public sealed class DebuginfodArgs
@@ -57,6 +60,18 @@ namespace DebuggerTesting.OpenDebug.CrossPlatCpp
         public int? Timeout { get; set; }
     }
 
+    public sealed class SymbolLoadInfoArgs
+    {
+        [JsonProperty("loadAll", DefaultValueHandling = DefaultValueHandling.Ignore)]
+        public bool? LoadAll { get; set; }
+
+        [JsonProperty("exceptionList", DefaultValueHandling = DefaultValueHandling.Ignore)]
+        public string ExceptionList { get; set; }
+
+        [JsonProperty("loadOnDemand", DefaultValueHandling = DefaultValueHandling.Ignore)]
+        public bool? LoadOnDemand { get; set; }
+    }
+
     public sealed class SetupCommandArg
     {
         [JsonProperty("text")]
@@ -174,6 +174,78 @@ namespace CppTests.Tests
             }
         }
 
+        [Theory]
+        [DependsOnTest(nameof(CompileKitchenSinkForExecution))]
+        [RequiresTestSettings]
+        public void ExecutionStepRecursiveCallEvaluate(ITestSettings settings)
+        {
+            this.TestPurpose("Verify locals and expressions evaluated again after stepping into a recursive call show the values of the new call");
+            this.WriteSettings(settings);
+
+            this.Comment("Open the kitchen sink debuggee for execution tests.");
+            IDebuggee debuggee = SinkHelper.Open(this, settings.CompilerSettings, DebuggeeMonikers.KitchenSink.Execution);
+
+            using (IDebuggerRunner runner = CreateDebugAdapterRunner(settings))
+            {
+                this.Comment("Configure launch");
+                runner.Launch(settings.DebuggerSettings, debuggee, "-fCalling");
+
+                this.Comment("Set initial function breakpoints");
+                FunctionBreakpoints funcBp = new FunctionBreakpoints("Calling::CoreRun()");
+                runner.SetFunctionBreakpoints(funcBp);
+
+                this.Comment("Launch and run until hit function breakpoint in the entry of calling");
+                runner.ExpectBreakpointAndStepToTarget(SinkHelper.Calling, startLine: 47, targetLine: 48).AfterConfigurationDone();
+
+                this.Comment("Step over to go to the entry of recursive call");
+                runner.Expects.HitStepEvent(SinkHelper.Calling, 49).AfterStepOver();
+
+                this.Comment("Step in the recursive call");
+                runner.ExpectStepAndStepToTarget(SinkHelper.Calling, startLine: 25, targetLine: 26).AfterStepIn();
+
+                using (IThreadInspector threadInspector = runner.GetThreadInspector())
+                {
+                    this.Comment("Evaluate count in the first call");
+                    IFrameInspector currentFrame = threadInspector.Stack.First();
+                    currentFrame.AssertVariables("count", "30");
+                    Assert.Equal("30", currentFrame.Evaluate("count", EvaluateContext.Watch));
+                }
+
+                this.Comment("Step over and then step in the recursive call once again");
+                runner.Expects.HitStepEvent(SinkHelper.Calling, 29).AfterStepOver();
+                using (IThreadInspector threadInspector = runner.GetThreadInspector())
+                {
+                    Assert.Equal("30", threadInspector.Stack.First().Evaluate("count", EvaluateContext.Watch));
+                }
+                runner.ExpectStepAndStepToTarget(SinkHelper.Calling, startLine: 25, targetLine: 26).AfterStepIn();
+
+                using (IThreadInspector threadInspector = runner.GetThreadInspector())
+                {
+                    this.Comment("Verify count is evaluated in the new call, and in the caller one frame up");
+                    IFrameInspector currentFrame = threadInspector.Stack.First();
+                    currentFrame.AssertVariables("count", "29");
+                    Assert.Equal("29", currentFrame.Evaluate("count", EvaluateContext.Watch));
+                    IFrameInspector callerFrame = threadInspector.Stack.ElementAt(1);
+                    callerFrame.AssertVariables("count", "30");
+                    Assert.Equal("30", callerFrame.Evaluate("count", EvaluateContext.Watch));
+                }
+
+                this.Comment("Step out to the first call");
+                runner.ExpectStepAndStepToTarget(SinkHelper.Calling, 29, 30).AfterStepOut();
+
+                using (IThreadInspector threadInspector = runner.GetThreadInspector())
+                {
+                    this.Comment("Verify count is evaluated in the first call again");
+                    IFrameInspector currentFrame = threadInspector.Stack.First();
+                    currentFrame.AssertVariables("count", "30");
+                    Assert.Equal("30", currentFrame.Evaluate("count", EvaluateContext.Watch));
+                }
+
+                this.Comment("Verify stop debugging");
+                runner.DisconnectAndVerify();
+            }
+        }
+
         [Theory]
         [DependsOnTest(nameof(CompileKitchenSinkForExecution))]
         [RequiresTestSettings]
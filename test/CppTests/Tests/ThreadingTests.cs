@@ -7,6 +7,7 @@ using System.Linq;
 using DebuggerTesting;
 using DebuggerTesting.Compilation;
 using DebuggerTesting.OpenDebug;
+using DebuggerTesting.OpenDebug.Commands;
 using DebuggerTesting.OpenDebug.CrossPlatCpp;
 using DebuggerTesting.OpenDebug.Events;
 using DebuggerTesting.OpenDebug.Extensions;
@@ -112,6 +113,105 @@ namespace CppTests.Tests
             }
         }
 
+        [Theory]
+        [DependsOnTest(nameof(CompileKitchenSinkForThreading))]
+        [RequiresTestSettings]
+        [UnsupportedDebugger(SupportedDebugger.VsDbg | SupportedDebugger.Lldb | SupportedDebugger.Gdb_MinGW | SupportedDebugger.Gdb_Cygwin, SupportedArchitecture.x64 | SupportedArchitecture.x86)]
+        public void ThreadingLoadSymbolsOnDemand(ITestSettings settings)
+        {
+            this.TestPurpose("Test that loading symbols while walking one thread's stack refreshes the other threads' stacks.");
+            this.WriteSettings(settings);
+
+            IDebuggee debuggee = SinkHelper.Open(this, settings.CompilerSettings, DebuggeeMonikers.KitchenSink.Threading);
+
+            using (IDebuggerRunner runner = CreateDebugAdapterRunner(settings))
+            {
+                this.Comment("Launching debuggee with symbols loaded on demand. Run until multiple threads are running.");
+                LaunchCommand launch = new LaunchCommand(settings.DebuggerSettings, debuggee.OutputPath, null, false, "-fThreading");
+                launch.Args.symbolLoadInfo = new SymbolLoadInfoArgs { LoadOnDemand = true };
+                runner.RunCommand(launch);
+                runner.SetBreakpoints(debuggee.Breakpoints(SinkHelper.Threading, 37));
+
+                runner.Expects.HitBreakpointEvent()
+                              .AfterConfigurationDone();
+
+                // Listing the threads caches the top frame of every thread before any worker's stack is walked
+                List<IThreadInfo> workers = runner.GetThreads().Where(t => t.Id != runner.StoppedThreadId).ToList();
+                Assert.True(workers.Count >= 2, "Expected at least 2 worker threads, but found " + workers.Count.ToString(CultureInfo.InvariantCulture));
+
+                // The first worker's walk loads symbols of the libraries the worker threads wait in, so every later
+                // walk must see them too, including the top frames cached before they were loaded
+                foreach (IThreadInfo threadInfo in workers)
+                {
+                    IThreadInspector threadInspector = threadInfo.GetThreadInspector();
+                    this.Comment("Thread '{0}', Id: {1}".FormatInvariantWithArgs(threadInfo.Name, threadInspector.ThreadId));
+
+                    List<string> frameNames = threadInspector.Stack.Select(frame => frame.Name).ToList();
+                    this.WriteLine("Stack Trace:");
+                    foreach (string name in frameNames)
+                    {
+                        this.WriteLine(name);
+                    }
+
+                    Assert.True(frameNames.Any(name => name.Contains("ThreadLoop")), "This thread's stack did not contain a frame with 'ThreadLoop'");
+                    Assert.True(frameNames.Any(name => name.Contains("condition_variable")), "This thread's stack did not contain a frame with 'condition_variable'");
+                }
+
+                this.Comment("Run to end.");
+                runner.Expects.TerminatedEvent().AfterContinue();
+
+                runner.DisconnectAndVerify();
+            }
+        }
+
+        [Theory]
+        [DependsOnTest(nameof(CompileKitchenSinkForThreading))]
+        [RequiresTestSettings]
+        [UnsupportedDebugger(SupportedDebugger.VsDbg, SupportedArchitecture.x64 | SupportedArchitecture.x86)]
+        public void ThreadingConcurrentRequests(ITestSettings settings)
+        {
+            this.TestPurpose("Test that requests sent without waiting for each other all succeed while the threads are stopped.");
+            this.WriteSettings(settings);
+
+            IDebuggee debuggee = SinkHelper.Open(this, settings.CompilerSettings, DebuggeeMonikers.KitchenSink.Threading);
+
+            using (IDebuggerRunner runner = CreateDebugAdapterRunner(settings))
+            {
+                this.Comment("Launching debuggee. Run until multiple threads are running.");
+                runner.Launch(settings.DebuggerSettings, debuggee, "-fThreading");
+                runner.SetBreakpoints(debuggee.Breakpoints(SinkHelper.Threading, 37));
+
+                runner.Expects.HitBreakpointEvent()
+                              .AfterConfigurationDone();
+
+                IThreadInfo worker = runner.GetThreads().First(t => t.Id != runner.StoppedThreadId);
+                IFrameInspector frame = runner.GetThreadInspector().Stack.First();
+                ScopesCommand scopes = new ScopesCommand(frame.Id);
+                runner.RunCommand(scopes);
+                int registersReference = scopes.ActualResponse.body.scopes.Single(s => s.name == "Registers").variablesReference.Value;
+
+                for (int i = 0; i < 3; i++)
+                {
+                    this.Comment("Request registers, a worker's stack, an evaluation and the threads at once.");
+                    VariablesCommand registers = new VariablesCommand(registersReference);
+                    StackTraceCommand stackTrace = new StackTraceCommand(worker.Id);
+                    EvaluateCommand evaluate = new EvaluateCommand("sizeof(this->runningWorkingThreadCount)", frame.Id);
+                    ThreadsCommand threads = new ThreadsCommand();
+                    ConcurrentCommands.Run(runner, registers, stackTrace, evaluate, threads);
+
+                    Assert.NotEmpty(registers.ActualResponse.body.variables);
+                    Assert.True(stackTrace.ActualResponse.body.stackFrames.Any(f => f.name.Contains("ThreadLoop")), "The worker's stack did not contain a frame with 'ThreadLoop'");
+                    Assert.Equal("4", evaluate.ActualResult);
+                    Assert.True(threads.ActualResponse.body.threads.Any(t => t.id == worker.Id), "The worker thread was not in the thread list");
+                }
+
+                this.Comment("Run to end.");
+                runner.Expects.TerminatedEvent().AfterContinue();
+
+                runner.DisconnectAndVerify();
+            }
+        }
+
         [Theory]
         [DependsOnTest(nameof(CompileKitchenSinkForThreading))]
         [RequiresTestSettings]
@@ -202,36 +202,6 @@ namespace DebuggerTesting.OpenDebug.Commands
             return new DebugAdapterResponse(response.DynamicResponse, response.IgnoreOrder, response.IgnoreResponseOrder);
         }
 
-        #region ActualResponse
-
-        /// <summary>
-        /// Provides a way to get the command to interperet the actual result
-        /// that comes back from the Debug Adapter.
-        /// </summary>
-        private class ActualResponse : IActualResponse
-        {
-            private string responseJson;
-
-            public ActualResponse(string responseJson)
-            {
-                this.responseJson = responseJson;
-            }
-
-            public R Convert<R>()
-            {
-                try
-                {
-                    return JsonConvert.DeserializeObject<R>(responseJson);
-                }
-                catch (JsonReaderException ex)
-                {
-                    throw new FormatException("Malformed JSON: " + responseJson, ex);
-                }
-            }
-        }
-
-        #endregion
-
         #endregion
 
         public override string ToString()
@@ -262,4 +232,30 @@ namespace DebuggerTesting.OpenDebug.Commands
             return this.ActualResponse;
         }
     }
+
+    /// <summary>
+    /// Provides a way to get the command to interperet the actual result
+    /// that comes back from the Debug Adapter.
+    /// </summary>
+    internal class ActualResponse : IActualResponse
+    {
+        private string responseJson;
+
+        public ActualResponse(string responseJson)
+        {
+            this.responseJson = responseJson;
+        }
+
+        public R Convert<R>()
+        {
+            try
+            {
+                return JsonConvert.DeserializeObject<R>(responseJson);
+            }
+            catch (JsonReaderException ex)
+            {
+                throw new FormatException("Malformed JSON: " + responseJson, ex);
+            }
+        }
+    }
 }
@@ -0,0 +1,76 @@
+﻿// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using DebugAdapterRunner;
+using Newtonsoft.Json;
+using OpenDebug;
+using DarRunner = DebugAdapterRunner.DebugAdapterRunner;
+
+namespace DebuggerTesting.OpenDebug.Commands
+{
+    /// <summary>
+    /// Runs several commands at once: every request is sent before any response is read, so the debug adapter
+    /// can work on them at the same time. Their responses may arrive in any order.
+    /// </summary>
+    public static class ConcurrentCommands
+    {
+        /// <summary>
+        /// Runs the commands concurrently and waits for all of their responses.
+        /// </summary>
+        /// <param name="commands">The commands to run. Responses are matched to commands by name, so the names must differ.</param>
+        public static void Run(IDebuggerRunner runner, params ICommand[] commands)
+        {
+            Parameter.ThrowIfNull(runner, nameof(runner));
+            Parameter.ThrowIfOutOfRange(commands.Length, 1, int.MaxValue, nameof(commands));
+            if (commands.Select(command => command.Name).Distinct().Count() != commands.Length)
+                throw new ArgumentException("Concurrent commands must have different names.", nameof(commands));
+
+            if (runner.ErrorEncountered)
+            {
+                runner.WriteLine("Previous error. Skipping commands '{0}'.", string.Join("', '", commands.Select(command => command.Name)));
+                return;
+            }
+
+            DarRunner darRunner = runner.DarRunner;
+            List<DebugAdapterResponse> darResponses = commands
+                .Select(command => new DebugAdapterResponse(command.ExpectedResponse.DynamicResponse, command.ExpectedResponse.IgnoreOrder, ignoreResponseOrder: true))
+                .ToList();
+
+            try
+            {
+                // Send all but the last request without reading the responses
+                foreach (ICommand command in commands.Take(commands.Length - 1))
+                {
+                    runner.WriteLine("Sending command {0}", command.ToString());
+                    DispatcherRequest request = new DispatcherRequest(darRunner.GetNextSequenceNumber(), command.Name, command.DynamicArgs);
+                    darRunner.DebugAdapter.StandardInput.Write(darRunner.SerializeMessage(request));
+                }
+
+                // Then run the last one, expecting the responses of all of them
+                ICommand last = commands[commands.Length - 1];
+                runner.WriteLine("Running command {0}", last.ToString());
+                darRunner.Run(new DebugAdapterCommand(last.Name, last.DynamicArgs, darResponses));
+
+                for (int i = 0; i < commands.Length; i++)
+                {
+                    commands[i].ProcessActualResponse(new ActualResponse(JsonConvert.SerializeObject(darResponses[i].Match)));
+                }
+            }
+            catch (Exception ex)
+            {
+                runner.ErrorEncountered = true;
+                runner.WriteLine("ERROR: Running commands concurrently. Exception thrown.");
+                runner.WriteLine(UDebug.ExceptionToString(ex));
+
+                // The DARException is not serializable, create a new exception
+                if (ex is DARException)
+                    throw new RunnerException(ex.Message);
+                else
+                    throw;
+            }
+        }
+    }
+}